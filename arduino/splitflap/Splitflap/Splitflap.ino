@@ -38,6 +38,10 @@
 #include "config.h"
 #include "src/splitflap_module.h"
 
+#if FRAME_CLOCK
+#error "FRAME_CLOCK is only supported by the ESP32 firmware"
+#endif
+
 #if SPI_IO
 #include "src/spi_io_config.h"
 #else
@@ -20,6 +20,241 @@
 // testing the split-flap, since home calibration can be tricky to fine tune)
 #define HOME_CALIBRATION_ENABLED true
 
+// Whether each module learns where its home sensor blip actually lands and
+// centers/narrows its expected home window on it, rather than always
+// accepting home within a fixed margin of the nominal position (see
+// src/home_calibration.h). On ESP32 the learned values are saved to NVS.
+#ifndef ADAPTIVE_HOME_WINDOWS
+#define ADAPTIVE_HOME_WINDOWS false
+#endif
+
+// Whether to resume from the last resting position after a warm reset
+// (software restart, OTA, panic, watchdog or brownout) instead of homing
+// every module (ESP32 only). Positions are kept in RTC memory while the chain
+// is at rest, and checked again at each module's next expected home blip.
+#ifndef WARM_BOOT_RESUME
+#define WARM_BOOT_RESUME false
+#endif
+
+// Whether homing searches for the home sensor at full speed rather than at
+// homing speed. The edge found at speed is used as a provisional reference;
+// the next time the module passes home it slows down through the expected
+// home window and takes the precise edge there.
+#ifndef FAST_HOMING
+#define FAST_HOMING false
+#endif
+
+// Whether homing at boot (and on a reset of the whole chain) is deferred per
+// module until the module is first sent a flap, so modules that aren't shown
+// stay unpowered and the first message doesn't wait for the whole chain to
+// home (ESP32 only). The remaining modules are homed in the background, at most
+// LAZY_HOMING_BACKGROUND_MODULES at a time and only while no commanded move is
+// waiting for a start slot. 0 leaves them unhomed until they are used.
+#ifndef LAZY_HOMING
+#define LAZY_HOMING false
+#endif
+
+#ifndef LAZY_HOMING_BACKGROUND_MODULES
+#define LAZY_HOMING_BACKGROUND_MODULES 4
+#endif
+
+// Whether to drive the motors in half steps (alternately one and two phases
+// on, 8 steps per electrical cycle) rather than full steps (two phases on, 4
+// steps per cycle). Half stepping is smoother and keeps more usable torque at
+// high step rates. Step counts and the default step periods are scaled to
+// match, so speeds are unchanged unless the profile periods are overridden
+// (see src/acceleration.h).
+#ifndef HALF_STEP_DRIVE
+#define HALF_STEP_DRIVE false
+#endif
+
+// Whether each module keeps a histogram of how late its steps fire (see
+// src/step_timing_stats.h). On ESP32 the histograms are collected every
+// STEP_TIMING_STATS_INTERVAL_MILLIS and sent to the host as StepTimingStats
+// messages (up to 64 modules each, from first_module on), to show step timing
+// degrading before it causes missed homes.
+#ifndef STEP_TIMING_STATS
+#define STEP_TIMING_STATS false
+#endif
+
+#ifndef STEP_TIMING_STATS_INTERVAL_MILLIS
+#define STEP_TIMING_STATS_INTERVAL_MILLIS 10000
+#endif
+
+// Whether each module has its own top speed cap, found by a calibration sweep
+// the host can start per module (ESP32 only). The sweep runs the module on the
+// FAST profile at ever shorter step periods (see src/acceleration.h) for
+// SPEED_CALIBRATION_REVOLUTIONS revolutions each, stops at the first period
+// that causes a missed or unexpected home, and caps the module
+// SPEED_CALIBRATION_MARGIN_PERCENT slower than the fastest clean period. The
+// caps are saved to NVS.
+#ifndef SPEED_CALIBRATION
+#define SPEED_CALIBRATION false
+#endif
+
+#ifndef SPEED_CALIBRATION_REVOLUTIONS
+#define SPEED_CALIBRATION_REVOLUTIONS 5
+#endif
+
+#ifndef SPEED_CALIBRATION_MARGIN_PERCENT
+#define SPEED_CALIBRATION_MARGIN_PERCENT 10
+#endif
+
+// Whether motor_sensor_io() queues each frame for DMA and returns while it's
+// clocked out, instead of waiting for both transfers (ESP32 only). The next
+// call collects it, so the loop's compute overlaps the transfer, at the cost
+// of sensor_buffer being one frame behind.
+#ifndef SPI_IO_ASYNC
+#define SPI_IO_ASYNC false
+#endif
+
+// Whether motor_sensor_io() shifts the motor data out and the sensor data in
+// with a single full-duplex SPI transaction (ESP32 only), rather than a write
+// followed by a separate read, halving the per-frame bus overhead. The shared
+// latch is pulsed before the frame to load the inputs and after it to latch the
+// outputs. If the SPI peripheral samples the inputs late and loses the first
+// bit (the chainlink loopback check fails), enable SPI_IO_FULL_DUPLEX_SKEW to
+// read that bit directly and shift the rest back into place.
+#ifndef SPI_IO_FULL_DUPLEX
+#define SPI_IO_FULL_DUPLEX false
+#endif
+
+#ifndef SPI_IO_FULL_DUPLEX_SKEW
+#define SPI_IO_FULL_DUPLEX_SKEW false
+#endif
+
+// Whether the modules are wired as two separate chains, the first
+// SPI_IO_SPLIT_MODULES on the usual SPI pins (HSPI) and the rest on a second
+// set (VSPI, see src/spi_io_config.h), so that both halves are shifted at the
+// same time and a frame takes about half as long (ESP32 only). The split must
+// fall on a whole number of sensor bytes: a multiple of 6 modules on chainlink
+// boards, 4 on classic ones. VSPI is the display's bus, so this can't be used
+// with ENABLE_DISPLAY (see the chainlinkBaseSplitChain environment).
+#ifndef SPI_IO_SPLIT_CHAIN
+#define SPI_IO_SPLIT_CHAIN false
+#endif
+
+#ifndef SPI_IO_SPLIT_MODULES
+#ifdef CHAINLINK
+#define SPI_IO_SPLIT_MODULES (NUM_MODULES / 12 * 6)
+#else
+#define SPI_IO_SPLIT_MODULES (NUM_MODULES / 8 * 4)
+#endif
+#endif
+
+// Whether to find the fastest SPI clock the chain runs reliably at when
+// starting up, instead of always using SPI_CLOCK (ESP32 chainlink boards only).
+// Starting at SPI_CLOCK_CALIBRATION_MIN_HZ and going up in steps of
+// SPI_CLOCK_CALIBRATION_STEP_HZ, each clock shifts
+// SPI_CLOCK_CALIBRATION_FRAMES pseudo-random patterns through the loopbacks.
+// The sweep stops at the first clock that reads any of them back wrong, and
+// the chain then runs SPI_CLOCK_CALIBRATION_MARGIN_PERCENT slower than the
+// fastest clean clock (or at SPI_CLOCK_CALIBRATION_MIN_HZ if nothing was).
+// The clock in use is reported in the state.
+#ifndef SPI_CLOCK_CALIBRATION
+#define SPI_CLOCK_CALIBRATION false
+#endif
+
+#ifndef SPI_CLOCK_CALIBRATION_MIN_HZ
+#define SPI_CLOCK_CALIBRATION_MIN_HZ 1000000
+#endif
+
+#ifndef SPI_CLOCK_CALIBRATION_MAX_HZ
+#define SPI_CLOCK_CALIBRATION_MAX_HZ 10000000
+#endif
+
+#ifndef SPI_CLOCK_CALIBRATION_STEP_HZ
+#define SPI_CLOCK_CALIBRATION_STEP_HZ 500000
+#endif
+
+#ifndef SPI_CLOCK_CALIBRATION_FRAMES
+#define SPI_CLOCK_CALIBRATION_FRAMES 64
+#endif
+
+#ifndef SPI_CLOCK_CALIBRATION_MARGIN_PERCENT
+#define SPI_CLOCK_CALIBRATION_MARGIN_PERCENT 20
+#endif
+
+// Whether to drive a simulated chain of modules (see src/virtual_board.h)
+// instead of the shift registers (ESP32 only), to run and load test the
+// firmware with no modules attached. The same backend lets SplitflapTask run
+// natively (see bench/task_bench.cpp).
+#ifndef VIRTUAL_IO
+#define VIRTUAL_IO false
+#endif
+
+// Fastest SPI clock the simulated chain reads back correctly at, for
+// SPI_CLOCK_CALIBRATION to find.
+#ifndef VIRTUAL_IO_MAX_CLOCK_HZ
+#define VIRTUAL_IO_MAX_CLOCK_HZ 6000000
+#endif
+
+// Whether the chainlink loopbacks are checked continuously all at once
+// (ESP32 only), each pass driving every loopback output with the next of a
+// short cycle of coded patterns and checking every input, rather than one
+// loopback at a time over 50 passes each. A broken or crossed loopback is then
+// found within a few passes instead of up to 50 per loopback in the chain, and
+// the failing input is still logged.
+#ifndef CODED_LOOPBACKS
+#define CODED_LOOPBACKS false
+#endif
+
+// Whether the home sensor's rising edges are latched on every motor_sensor_io()
+// frame and held for the module's next step, instead of sampling the sensor
+// only on the frame a step is taken. Keeps a home blip narrower than a step
+// from being missed at high step rates. Requires SPI_IO or VIRTUAL_IO.
+#ifndef SENSOR_EDGE_LATCH
+#define SENSOR_EDGE_LATCH false
+#endif
+
+// Number of motor_sensor_io() frames in a row a home sensor must read a new
+// level for before the modules see it change (1 to 16; 1 disables the filter).
+// Filters out single-frame home blips from noise on long chains, which would
+// otherwise cost an unexpected-home recalibration; a real home blip must then
+// last at least this many frames, and is seen this many frames minus one late.
+// Requires SPI_IO or VIRTUAL_IO.
+#ifndef SENSOR_DEBOUNCE_FRAMES
+#define SENSOR_DEBOUNCE_FRAMES 1
+#endif
+
+// Whether to step all modules with the structure-of-arrays SplitflapBatch
+// engine (one pass over the whole chain per update) instead of individual
+// SplitflapModule instances. Requires SPI_IO.
+#ifndef BATCH_STEPPING
+#define BATCH_STEPPING false
+#endif
+
+// Whether to step modules on a fixed-rate frame clock (ESP32 only). A hardware
+// timer paces motor_sensor_io() once per frame and step periods are counted in
+// whole frames (see FRAME_CLOCK_PERIOD_MICROS in src/acceleration.h), so step
+// timing no longer depends on how long the rest of the update loop takes.
+#ifndef FRAME_CLOCK
+#define FRAME_CLOCK false
+#endif
+
+// Maximum number of modules per power channel that may be accelerating from a
+// stop at the same time (ESP32 only). A starting module holds one of its
+// channel's slots until it reaches the speed it's heading for, starts slowing
+// down or stops (or for at most MODULE_START_TIMEOUT_MILLIS); further starts
+// are held back until a slot is free, so a full-screen message (or homing at
+// boot) doesn't draw every motor's starting current at once. 0 disables the
+// limit. Power channels are assigned by getPowerChannelForModuleIndex() in
+// esp32/core/power_channels.h.
+#ifndef MAX_MODULE_STARTS_PER_POWER_CHANNEL
+#define MAX_MODULE_STARTS_PER_POWER_CHANNEL 0
+#endif
+
+#ifndef MODULE_START_TIMEOUT_MILLIS
+#define MODULE_START_TIMEOUT_MILLIS 500
+#endif
+
+// Number of flap targets (with dwell times) that can be queued per module
+// ahead of its current move (ESP32 only), so animations can be streamed
+// without waiting for each module to stop.
+#ifndef TARGET_QUEUE_DEPTH
+#define TARGET_QUEUE_DEPTH 4
+#endif
+
 // 3) Flap Contents & Order
 #define NUM_FLAPS (40)
 
@@ -125,6 +360,12 @@ const uint8_t flaps[NUM_FLAPS] = {
  *     39 MISO          (in)
  *     32 MOSI          (out)
  *
+ *   Second chain, with SPI_IO_SPLIT_CHAIN:
+ *     13 Latch         (out)
+ *     15 CLK           (out)
+ *     38 MISO          (in)
+ *      2 MOSI          (out)
+ *
  */
 
 
@@ -136,3 +377,6 @@ const uint8_t flaps[NUM_FLAPS] = {
 #define NUM_LOOPBACKS (NUM_MODULES / 3)
 #define CHAINLINK_ENFORCE_LOOPBACKS 1
 #endif
+#if SPI_CLOCK_CALIBRATION && !defined(CHAINLINK)
+#error SPI_CLOCK_CALIBRATION tests the chain through the chainlink loopbacks
+#endif
@@ -14,14 +14,185 @@
    limitations under the License.
 */
 
-// NOTE: THIS FILE IS AUTOGENERATED! DO NOT MODIFY!
-// To update, run `arduino/splitflap/Splitflap/src/generate_acceleration.py`
-
 #ifndef ACCELERATION
 #define ACCELERATION
 
+#include "acceleration_profile.h"
+#include "../config.h"
+
+// Motion profile settings. Any of these can be overridden per environment with build flags in platformio.ini
+// (e.g. -DACCEL_MIN_PERIOD_MICROS=1400 -DACCEL_CURVE=ACCEL_CURVE_S) to tune a profile; the step period tables are
+// generated at compile time (see acceleration_profile.h).
+//
+// The settings below describe the NORMAL profile. FAST and QUIET are variations of it that can be selected per module
+// at runtime (see MotionProfileId), e.g. to let new modules run faster or to slow down modules with worn gears.
+//
+// Periods are per motor step. With HALF_STEP_DRIVE each step is half as far, so the default periods are halved to keep
+// the same speeds; an overridden period is taken as given.
+
+#if HALF_STEP_DRIVE
+#define _ACCEL_STEPS_PER_FULL_STEP 2
+#else
+#define _ACCEL_STEPS_PER_FULL_STEP 1
+#endif
+
+// Step period at full speed
+#ifndef ACCEL_MIN_PERIOD_MICROS
+#define ACCEL_MIN_PERIOD_MICROS (1600 / _ACCEL_STEPS_PER_FULL_STEP)
+#endif
+
+// Step period of the first step when starting from a stop
+#ifndef ACCEL_MAX_PERIOD_MICROS
+#define ACCEL_MAX_PERIOD_MICROS (10000 / _ACCEL_STEPS_PER_FULL_STEP)
+#endif
+
+// Time to ramp from ACCEL_MAX_PERIOD_MICROS to ACCEL_MIN_PERIOD_MICROS
+#ifndef ACCEL_TIME_MICROS
+#define ACCEL_TIME_MICROS 200000
+#endif
+
+// How often a stopped module re-checks its state
+#ifndef ACCEL_IDLE_PERIOD_MICROS
+#define ACCEL_IDLE_PERIOD_MICROS 1600
+#endif
+
+// ACCEL_CURVE_LINEAR or ACCEL_CURVE_S
+#ifndef ACCEL_CURVE
+#define ACCEL_CURVE ACCEL_CURVE_LINEAR
+#endif
+
+// FAST profile: same ramp as NORMAL up to a higher top speed
+#ifndef ACCEL_FAST_MIN_PERIOD_MICROS
+#define ACCEL_FAST_MIN_PERIOD_MICROS (1200 / _ACCEL_STEPS_PER_FULL_STEP)
+#endif
+
+// QUIET profile: lower top speed reached over a longer, jerk-limited ramp
+#ifndef ACCEL_QUIET_MIN_PERIOD_MICROS
+#define ACCEL_QUIET_MIN_PERIOD_MICROS (2400 / _ACCEL_STEPS_PER_FULL_STEP)
+#endif
+
+#ifndef ACCEL_QUIET_TIME_MICROS
+#define ACCEL_QUIET_TIME_MICROS 300000
+#endif
+
+// With SPEED_CALIBRATION, the FAST profile's ramp carries on down to ACCEL_CALIBRATION_MIN_PERIOD_MICROS and each
+// module is capped at its own minimum step period instead: ACCEL_FAST_MIN_PERIOD_MICROS until it has been calibrated,
+// so uncalibrated modules run as before. The ramp time is stretched in proportion, so it accelerates at the same rate
+// as without SPEED_CALIBRATION. The calibration sweep tries periods from ACCEL_MIN_PERIOD_MICROS down to
+// ACCEL_CALIBRATION_MIN_PERIOD_MICROS in steps of ACCEL_CALIBRATION_PERIOD_STEP_MICROS. With HALF_STEP_DRIVE the
+// default stops short of 900us per full step, since the longer ramp would no longer fit in 254 steps.
+#ifndef ACCEL_CALIBRATION_MIN_PERIOD_MICROS
+#if HALF_STEP_DRIVE
+#define ACCEL_CALIBRATION_MIN_PERIOD_MICROS (1100 / _ACCEL_STEPS_PER_FULL_STEP)
+#else
+#define ACCEL_CALIBRATION_MIN_PERIOD_MICROS (900 / _ACCEL_STEPS_PER_FULL_STEP)
+#endif
+#endif
+
+#ifndef ACCEL_CALIBRATION_PERIOD_STEP_MICROS
+#define ACCEL_CALIBRATION_PERIOD_STEP_MICROS (100 / _ACCEL_STEPS_PER_FULL_STEP)
+#endif
+
+#if SPEED_CALIBRATION
+#define _ACCEL_FAST_TABLE_MIN_PERIOD_MICROS ACCEL_CALIBRATION_MIN_PERIOD_MICROS
+// Same velocity gain per microsecond as a ramp from ACCEL_MAX_PERIOD_MICROS to ACCEL_FAST_MIN_PERIOD_MICROS over
+// ACCEL_TIME_MICROS; with ACCEL_CURVE_LINEAR the table then matches that ramp step for step up to its end.
+#define _ACCEL_FAST_TIME_MICROS ((uint32_t)((uint64_t)ACCEL_TIME_MICROS \
+        * (ACCEL_MAX_PERIOD_MICROS - ACCEL_CALIBRATION_MIN_PERIOD_MICROS) * ACCEL_FAST_MIN_PERIOD_MICROS \
+        / ((uint64_t)(ACCEL_MAX_PERIOD_MICROS - ACCEL_FAST_MIN_PERIOD_MICROS) * ACCEL_CALIBRATION_MIN_PERIOD_MICROS)))
+#else
+#define _ACCEL_FAST_TABLE_MIN_PERIOD_MICROS ACCEL_FAST_MIN_PERIOD_MICROS
+#define _ACCEL_FAST_TIME_MICROS ACCEL_TIME_MICROS
+#endif
+
+// Frame period for FRAME_CLOCK mode. Step periods are rounded to whole frames (never faster than a profile's minimum
+// period), so this should divide every profile's minimum period evenly to keep the full top speed, and must be long
+// enough for a complete motor_sensor_io() round trip plus the module updates for the whole chain (with SPI_IO_ASYNC,
+// the longer of the two).
+#ifndef FRAME_CLOCK_PERIOD_MICROS
+#define FRAME_CLOCK_PERIOD_MICROS (400 / _ACCEL_STEPS_PER_FULL_STEP)
+#endif
+
 namespace Acceleration {
-    const PROGMEM uint16_t ACCEL_STEP_PERIODS[] = {1600, 10000, 7920, 6800, 6064, 5530, 5119, 4790, 4518, 4288, 4090, 3918, 3766, 3631, 3510, 3400, 3300, 3208, 3123, 3045, 2973, 2906, 2843, 2783, 2728, 2676, 2626, 2580, 2535, 2493, 2453, 2415, 2379, 2344, 2310, 2278, 2248, 2218, 2190, 2163, 2137, 2111, 2087, 2063, 2040, 2018, 1997, 1976, 1956, 1937, 1918, 1900, 1882, 1864, 1848, 1831, 1815, 1800, 1784, 1770, 1755, 1741, 1727, 1714, 1701, 1688, 1675, 1663, 1651, 1639, 1628, 1617, 1606};
-    const uint8_t MAX_ACCEL_STEP = 72;
+    typedef Profile<
+        ACCEL_MIN_PERIOD_MICROS,
+        ACCEL_MAX_PERIOD_MICROS,
+        ACCEL_TIME_MICROS,
+        ACCEL_IDLE_PERIOD_MICROS,
+        ACCEL_CURVE> DefaultProfile;
+
+    typedef Profile<
+        _ACCEL_FAST_TABLE_MIN_PERIOD_MICROS,
+        ACCEL_MAX_PERIOD_MICROS,
+        _ACCEL_FAST_TIME_MICROS,
+        ACCEL_IDLE_PERIOD_MICROS,
+        ACCEL_CURVE> FastProfile;
+
+    typedef Profile<
+        ACCEL_QUIET_MIN_PERIOD_MICROS,
+        ACCEL_MAX_PERIOD_MICROS,
+        ACCEL_QUIET_TIME_MICROS,
+        ACCEL_IDLE_PERIOD_MICROS,
+        ACCEL_CURVE_S> QuietProfile;
+
+    const uint8_t MAX_ACCEL_STEP = DefaultProfile::MAX_ACCEL_STEP;
+    const uint16_t* const ACCEL_STEP_PERIODS = PeriodTable<DefaultProfile, 1>::PERIODS;
+
+    // ACCEL_STEP_PERIODS expressed in whole frames, for FRAME_CLOCK mode
+    const uint16_t FRAME_PERIOD_MICROS = FRAME_CLOCK_PERIOD_MICROS;
+    const uint16_t* const ACCEL_STEP_FRAMES = PeriodTable<DefaultProfile, FRAME_PERIOD_MICROS>::PERIODS;
+
+    // Modules search for home at the speed the NORMAL profile reaches after 1/8th of its ramp, whichever profile they
+    // are using, so the home sensor is sampled the same way everywhere.
+    const uint16_t HOMING_PERIOD_MICROS = DefaultProfile::Period(DefaultProfile::MAX_ACCEL_STEP / 8);
+
+    // Values match the motion_profile field of PB_SplitflapConfig_ModuleConfig
+    enum MotionProfileId : uint8_t {
+        MOTION_PROFILE_NORMAL,
+        MOTION_PROFILE_FAST,
+        MOTION_PROFILE_QUIET,
+        NUM_MOTION_PROFILES,
+    };
+
+    struct MotionProfile {
+        const uint16_t* periods;  // PROGMEM step period table (in frames with FRAME_CLOCK)
+        uint8_t max_accel_step;
+        uint8_t homing_accel_step;
+    };
+
+#if FRAME_CLOCK
+#define _MOTION_PROFILE_PERIOD_UNIT FRAME_PERIOD_MICROS
+#else
+#define _MOTION_PROFILE_PERIOD_UNIT 1
+#endif
+#define _MOTION_PROFILE(P) { \
+        PeriodTable<P, _MOTION_PROFILE_PERIOD_UNIT>::PERIODS, \
+        P::MAX_ACCEL_STEP, \
+        P::AccelStepForPeriod(HOMING_PERIOD_MICROS, P::MAX_ACCEL_STEP), \
+    }
+
+    const MotionProfile MOTION_PROFILES[NUM_MOTION_PROFILES] = {
+        _MOTION_PROFILE(DefaultProfile),
+        _MOTION_PROFILE(FastProfile),
+        _MOTION_PROFILE(QuietProfile),
+    };
+
+#if SPEED_CALIBRATION
+    // Highest accel step of profile whose period is no shorter than min_period_micros. At least 1, so that a capped
+    // module still moves.
+    inline uint8_t MaxAccelStepForMinPeriod(const MotionProfile& profile, uint16_t min_period_micros) {
+        uint8_t accel_step = profile.max_accel_step;
+        while (accel_step > 1
+                && (uint32_t)pgm_read_word_near(profile.periods + accel_step) * _MOTION_PROFILE_PERIOD_UNIT < min_period_micros) {
+            accel_step--;
+        }
+        return accel_step;
+    }
+#endif
+
+#undef _MOTION_PROFILE
+#undef _MOTION_PROFILE_PERIOD_UNIT
+#undef _ACCEL_FAST_TABLE_MIN_PERIOD_MICROS
+#undef _ACCEL_FAST_TIME_MICROS
 }
 #endif
@@ -0,0 +1,129 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ACCELERATION_PROFILE_H
+#define ACCELERATION_PROFILE_H
+
+#include <Arduino.h>
+
+#include "index_sequence.h"
+
+// Compile-time generator for acceleration step period tables.
+//
+// A profile ramps velocity from 1/MAX_PERIOD to 1/MIN_PERIOD (steps per microsecond) over ACCEL_TIME microseconds,
+// following one of the curves below. Entry 0 of the generated table is the idle period (how often a stopped module
+// re-checks its state); entry i (1 <= i <= MAX_ACCEL_STEP) is the period of the i-th step of the ramp, i.e. the step
+// that starts at the time the previous i-1 periods add up to. The same table is walked backwards when decelerating.
+//
+// Everything is computed with exact integer arithmetic in C++11 constexpr functions, so the tables are identical on
+// every target (AVR's 32-bit double would otherwise round differently from the ESP32's) and end up in flash like a
+// hand-written PROGMEM array.
+
+#define ACCEL_CURVE_LINEAR 0 // Constant acceleration
+#define ACCEL_CURVE_S 1 // Jerk-limited: acceleration rises from and falls back to zero (smoothstep velocity curve)
+
+namespace Acceleration {
+
+// Resolution of the normalized ramp time used to evaluate the S-curve polynomial
+const uint32_t S_CURVE_SCALE = 4096;
+
+template <uint16_t MIN_PERIOD, uint16_t MAX_PERIOD, uint32_t ACCEL_TIME, uint16_t IDLE_PERIOD, uint8_t CURVE>
+struct ProfileMath {
+  static_assert(MIN_PERIOD > 0 && MIN_PERIOD <= MAX_PERIOD, "MIN_PERIOD must be positive and at most MAX_PERIOD");
+  static_assert(ACCEL_TIME > 0, "ACCEL_TIME must be positive");
+  static_assert(CURVE == ACCEL_CURVE_LINEAR || CURVE == ACCEL_CURVE_S, "Unknown acceleration curve");
+
+  // Period at the point where velocity has covered num/den of the range from 1/MAX_PERIOD to 1/MIN_PERIOD. Inverting
+  // v = 1/MAX + (1/MIN - 1/MAX) * num/den gives MAX * MIN * den / (MIN * den + (MAX - MIN) * num); truncated like the
+  // original floating point generator did.
+  static constexpr uint16_t PeriodAtFraction(uint64_t num, uint64_t den) {
+    return (uint64_t)MAX_PERIOD * MIN_PERIOD * den / ((uint64_t)MIN_PERIOD * den + (uint64_t)(MAX_PERIOD - MIN_PERIOD) * num);
+  }
+
+  // Smoothstep 3x^2 - 2x^3 for x = x_scaled / S_CURVE_SCALE, scaled by S_CURVE_SCALE
+  static constexpr uint64_t SCurve(uint64_t x_scaled) {
+    return (3 * x_scaled * x_scaled * S_CURVE_SCALE - 2 * x_scaled * x_scaled * x_scaled) / ((uint64_t)S_CURVE_SCALE * S_CURVE_SCALE);
+  }
+
+  // Period of the ramp step starting t microseconds into the ramp
+  static constexpr uint16_t PeriodAtTime(uint32_t t) {
+    return CURVE == ACCEL_CURVE_S
+        ? PeriodAtFraction(SCurve((uint64_t)t * S_CURVE_SCALE / ACCEL_TIME), S_CURVE_SCALE)
+        : PeriodAtFraction(t, ACCEL_TIME);
+  }
+
+  static constexpr uint32_t NextStepTime(uint32_t t) {
+    return t + PeriodAtTime(t);
+  }
+
+  // Start time of ramp step i (1-based)
+  static constexpr uint32_t StepTime(uint16_t i) {
+    return i <= 1 ? 0 : NextStepTime(StepTime(i - 1));
+  }
+
+  static constexpr uint16_t CountSteps(uint32_t t) {
+    return t < ACCEL_TIME ? 1 + CountSteps(NextStepTime(t)) : 0;
+  }
+
+  // Table entry i in microseconds
+  static constexpr uint16_t Period(uint16_t i) {
+    return i == 0 ? IDLE_PERIOD : PeriodAtTime(StepTime(i));
+  }
+
+  // Table entry i rounded to the nearest whole multiple of unit_micros. Ramp steps are never rounded to anything
+  // shorter than MIN_PERIOD, so the top speed is only preserved exactly if unit_micros divides MIN_PERIOD.
+  static constexpr uint16_t PeriodInUnits(uint16_t i, uint16_t unit_micros) {
+    return i == 0
+        ? Max(1, (IDLE_PERIOD + unit_micros / 2) / unit_micros)
+        : Max((MIN_PERIOD + unit_micros - 1) / unit_micros, (Period(i) + unit_micros / 2) / unit_micros);
+  }
+
+  // First ramp step (1-based) that is at least as fast as `period` microseconds, or max_accel_step if the ramp never
+  // gets that fast. Used to cap a profile at a fixed speed, e.g. while homing.
+  static constexpr uint8_t AccelStepForPeriod(uint16_t period, uint8_t max_accel_step, uint8_t i = 1) {
+    return i >= max_accel_step || Period(i) <= period ? i : AccelStepForPeriod(period, max_accel_step, i + 1);
+  }
+
+  static constexpr uint16_t Max(uint32_t a, uint32_t b) {
+    return a > b ? a : b;
+  }
+};
+
+template <uint16_t MIN_PERIOD, uint16_t MAX_PERIOD, uint32_t ACCEL_TIME, uint16_t IDLE_PERIOD, uint8_t CURVE>
+struct Profile : ProfileMath<MIN_PERIOD, MAX_PERIOD, ACCEL_TIME, IDLE_PERIOD, CURVE> {
+  typedef ProfileMath<MIN_PERIOD, MAX_PERIOD, ACCEL_TIME, IDLE_PERIOD, CURVE> Math;
+
+  static_assert(Math::CountSteps(0) >= 1 && Math::CountSteps(0) <= 254, "Number of ramp steps must fit in a uint8_t accel step");
+  static const uint8_t MAX_ACCEL_STEP = Math::CountSteps(0);
+};
+
+// Flash table of Profile P's periods in units of UNIT_MICROS (1 for microseconds, or the frame period)
+template <class P, uint16_t UNIT_MICROS, class Indexes = typename MakeIndexSequence<P::MAX_ACCEL_STEP + 1>::Type>
+struct PeriodTable;
+
+template <class P, uint16_t UNIT_MICROS, uint16_t... Is>
+struct PeriodTable<P, UNIT_MICROS, IndexSequence<Is...>> {
+  static const uint16_t PERIODS[sizeof...(Is)];
+};
+
+template <class P, uint16_t UNIT_MICROS, uint16_t... Is>
+const uint16_t PeriodTable<P, UNIT_MICROS, IndexSequence<Is...>>::PERIODS[sizeof...(Is)] PROGMEM = {
+  P::PeriodInUnits(Is, UNIT_MICROS)...
+};
+
+}
+
+#endif
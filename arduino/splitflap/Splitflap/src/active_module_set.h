@@ -0,0 +1,91 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ACTIVE_MODULE_SET_H
+#define ACTIVE_MODULE_SET_H
+
+#include <Arduino.h>
+
+// Set of module indexes that need to be updated on every pass of the update loop. Modules that are idle (see
+// SplitflapModule::IsIdle) can be removed so that the cost of a pass scales with the number of moving modules rather
+// than the length of the chain; they must be added back whenever they're sent a command or their home sensor input
+// changes.
+//
+// Membership is tracked both as a dense list (for iteration) and a per-module flag (for O(1) Add/Contains).
+template <uint8_t MAX_MODULES>
+class ActiveModuleSet {
+ public:
+  ActiveModuleSet() {
+    memset(member_, 0, sizeof(member_));
+  }
+
+  inline void Add(uint8_t module) {
+    if (!member_[module]) {
+      member_[module] = true;
+      list_[size_++] = module;
+    }
+  }
+
+  void AddAll(uint8_t num_modules) {
+    for (uint8_t i = 0; i < num_modules; i++) {
+      Add(i);
+    }
+  }
+
+  inline bool Contains(uint8_t module) const {
+    return member_[module];
+  }
+
+  inline uint8_t Size() const {
+    return size_;
+  }
+
+  // Module index at position n of the set (0 <= n < Size())
+  inline uint8_t operator[](uint8_t n) const {
+    return list_[n];
+  }
+
+  // Removes the module at position n by moving the last entry into its place. Iterating from the end of the set
+  // (n = Size() - 1 down to 0) therefore visits every entry exactly once even while removing.
+  inline void RemoveAt(uint8_t n) {
+    member_[list_[n]] = false;
+    list_[n] = list_[--size_];
+  }
+
+  // Adds every module whose home sensor input differs between `sensor_buffer` and the `previous` snapshot, then
+  // updates the snapshot. Sensor byte b holds the inputs for modules b*modules_per_byte onward in its low bits; any
+  // other bits (e.g. chainlink loopback inputs) are ignored.
+  void AddSensorChanges(const uint8_t* sensor_buffer, uint8_t* previous, uint8_t length, uint8_t modules_per_byte, uint8_t num_modules) {
+    const uint8_t module_mask = (1 << modules_per_byte) - 1;
+    uint8_t first_module = 0;
+    for (uint8_t b = 0; b < length; b++, first_module += modules_per_byte) {
+      uint8_t changed = (sensor_buffer[b] ^ previous[b]) & module_mask;
+      previous[b] = sensor_buffer[b];
+      for (uint8_t bit = 0; changed != 0; bit++, changed >>= 1) {
+        if ((changed & 1) && first_module + bit < num_modules) {
+          Add(first_module + bit);
+        }
+      }
+    }
+  }
+
+ private:
+  uint8_t list_[MAX_MODULES];
+  bool member_[MAX_MODULES];
+  uint8_t size_ = 0;
+};
+
+#endif
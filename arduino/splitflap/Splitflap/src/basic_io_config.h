@@ -21,6 +21,10 @@
 
 #include "splitflap_module.h"
 
+#if BATCH_STEPPING
+#error "BATCH_STEPPING requires SPI_IO; modules driven directly from IO ports are not supported"
+#endif
+
 #if defined(__AVR_ATmega168__) || defined(__AVR_ATmega328P__)
   #if NUM_MODULES > 3
   #error "Basic IO mode only supports up to 3 modules on Atmega168/328-based boards. Set NUM_MODULES to 3 or fewer."
@@ -0,0 +1,92 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef FLAP_BOUNDARIES_H
+#define FLAP_BOUNDARIES_H
+
+#include <Arduino.h>
+
+#include "index_sequence.h"
+
+// Compile-time table of the motor steps at which each flap is reached, so that positions can be converted between
+// steps and flaps without any division at runtime.
+//
+// INPUT_STEPS motor steps turn the spool through OUTPUT_FLAPS flaps (a whole number of revolutions of FLAPS flaps).
+// The "flap floor" of a step s is floor(s * OUTPUT_FLAPS / INPUT_STEPS); entry k of the table is the first step whose
+// flap floor is k, i.e. ceil(k * INPUT_STEPS / OUTPUT_FLAPS). The table runs past OUTPUT_FLAPS by one revolution so a
+// target up to a full revolution beyond any position can be looked up directly.
+
+template <bool FITS_16_BITS> struct FlapStepType { typedef uint32_t Type; };
+template <> struct FlapStepType<true> { typedef uint16_t Type; };
+
+template <uint32_t INPUT_STEPS, uint16_t OUTPUT_FLAPS>
+constexpr uint32_t FlapBoundaryStep(uint16_t k) {
+  return ((uint64_t)k * INPUT_STEPS + OUTPUT_FLAPS - 1) / OUTPUT_FLAPS;
+}
+
+inline uint32_t ReadFlapStep(const uint16_t* entry) {
+  return pgm_read_word_near(entry);
+}
+
+inline uint32_t ReadFlapStep(const uint32_t* entry) {
+  return pgm_read_dword_near(entry);
+}
+
+template <uint32_t INPUT_STEPS, uint16_t OUTPUT_FLAPS, uint8_t FLAPS,
+    class Indexes = typename MakeIndexSequence<OUTPUT_FLAPS + FLAPS + 1>::Type>
+struct FlapBoundaries;
+
+template <uint32_t INPUT_STEPS, uint16_t OUTPUT_FLAPS, uint8_t FLAPS, uint16_t... Is>
+struct FlapBoundaries<INPUT_STEPS, OUTPUT_FLAPS, FLAPS, IndexSequence<Is...>> {
+  static_assert(OUTPUT_FLAPS % FLAPS == 0, "OUTPUT_FLAPS must be a whole number of revolutions");
+  static_assert(OUTPUT_FLAPS <= INPUT_STEPS, "Each flap must be at least one motor step");
+  static_assert(OUTPUT_FLAPS + FLAPS <= 255, "Flap positions must fit in a uint8_t");
+
+  typedef typename FlapStepType<FlapBoundaryStep<INPUT_STEPS, OUTPUT_FLAPS>(OUTPUT_FLAPS + FLAPS) <= 0xFFFF>::Type StepType;
+  static const StepType STEPS[sizeof...(Is)];
+
+  // First step of flap k (0 <= k <= OUTPUT_FLAPS + FLAPS)
+  static inline uint32_t StepForFlap(uint8_t k) {
+    return ReadFlapStep(STEPS + k);
+  }
+
+  // Step at which to stop to show target_flap_index when starting from flap floor from_flap (whose index on the spool
+  // is from_flap_index). Always moves forward, and goes all the way around if the target is already showing.
+  static inline uint32_t TargetStep(uint8_t from_flap, uint8_t from_flap_index, uint8_t target_flap_index) {
+    uint8_t delta_flaps = target_flap_index > from_flap_index
+        ? target_flap_index - from_flap_index
+        : FLAPS + target_flap_index - from_flap_index;
+    return StepForFlap(from_flap + delta_flaps);
+  }
+
+  // First step after `step` (0 <= step < INPUT_STEPS) at which flap index 0 starts showing
+  static inline uint32_t NextHomeStep(uint32_t step) {
+    uint8_t k = FLAPS;
+    while (StepForFlap(k) <= step) {
+      k += FLAPS;
+    }
+    return StepForFlap(k);
+  }
+};
+
+template <uint32_t INPUT_STEPS, uint16_t OUTPUT_FLAPS, uint8_t FLAPS, uint16_t... Is>
+const typename FlapBoundaries<INPUT_STEPS, OUTPUT_FLAPS, FLAPS, IndexSequence<Is...>>::StepType
+    FlapBoundaries<INPUT_STEPS, OUTPUT_FLAPS, FLAPS, IndexSequence<Is...>>::STEPS[sizeof...(Is)] PROGMEM = {
+  (typename FlapBoundaries<INPUT_STEPS, OUTPUT_FLAPS, FLAPS, IndexSequence<Is...>>::StepType)
+      FlapBoundaryStep<INPUT_STEPS, OUTPUT_FLAPS>(Is)...
+};
+
+#endif
@@ -0,0 +1,90 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef HOME_CALIBRATION_H
+#define HOME_CALIBRATION_H
+
+#include <Arduino.h>
+
+// Learned position of a module's home sensor blip (see ADAPTIVE_HOME_WINDOWS in config.h).
+//
+// Every home blip seen in the EXPECTED window is compared against the step where the gear ratio says home should be.
+// The offset is an exponential moving average of that error and the spread is a moving average of its absolute
+// deviation from the offset, both in fixed point (1/HOME_CALIBRATION_SCALE steps). Once enough blips have been seen
+// the EXPECTED window is centered on the learned offset and narrowed to a few spreads either side, never wider than
+// the fixed margin it replaces.
+
+// Fixed point scale of offset and spread
+#define HOME_CALIBRATION_SCALE 16
+
+// Weight of each new blip in the moving averages is 1/HOME_CALIBRATION_SMOOTHING
+#define HOME_CALIBRATION_SMOOTHING 8
+
+// Number of blips to learn from before the learned window is used
+#define HOME_CALIBRATION_MIN_SAMPLES 8
+
+// Half-width of the learned window: HOME_CALIBRATION_MIN_MARGIN_STEPS plus this many spreads
+#define HOME_CALIBRATION_MARGIN_SPREADS 4
+#define HOME_CALIBRATION_MIN_MARGIN_STEPS 3
+
+struct HomeCalibration {
+  int16_t offset;   // Mean blip position relative to the expected home step
+  uint16_t spread;  // Mean absolute deviation of the blip position from offset
+  uint8_t samples;  // Blips learned from, saturating at HOME_CALIBRATION_MIN_SAMPLES
+
+  // Records a home blip found error_steps after the expected home step
+  void Learn(int16_t error_steps) {
+    int16_t error = error_steps * HOME_CALIBRATION_SCALE;
+    if (samples == 0) {
+      offset = error;
+      spread = 0;
+    } else {
+      int16_t deviation = error > offset ? error - offset : offset - error;
+      offset += (error - offset) / HOME_CALIBRATION_SMOOTHING;
+      spread += (deviation - (int16_t)spread) / HOME_CALIBRATION_SMOOTHING;
+    }
+    if (samples < HOME_CALIBRATION_MIN_SAMPLES) {
+      samples++;
+    }
+  }
+
+  // Where the window should be centered relative to the expected home step, limited to +/- max_margin_steps
+  int16_t OffsetSteps(uint16_t max_margin_steps) const {
+    if (samples < HOME_CALIBRATION_MIN_SAMPLES) {
+      return 0;
+    }
+    int16_t steps = (offset + (offset >= 0 ? HOME_CALIBRATION_SCALE / 2 : -HOME_CALIBRATION_SCALE / 2)) / HOME_CALIBRATION_SCALE;
+    if (steps > (int16_t)max_margin_steps) {
+      return max_margin_steps;
+    }
+    if (steps < -(int16_t)max_margin_steps) {
+      return -(int16_t)max_margin_steps;
+    }
+    return steps;
+  }
+
+  // Number of steps either side of the window center that a blip is accepted, at most max_margin_steps
+  uint16_t MarginSteps(uint16_t max_margin_steps) const {
+    if (samples < HOME_CALIBRATION_MIN_SAMPLES) {
+      return max_margin_steps;
+    }
+    uint32_t margin = HOME_CALIBRATION_MIN_MARGIN_STEPS
+        + ((uint32_t)spread * HOME_CALIBRATION_MARGIN_SPREADS + HOME_CALIBRATION_SCALE - 1) / HOME_CALIBRATION_SCALE;
+    return margin < max_margin_steps ? margin : max_margin_steps;
+  }
+};
+
+#endif
@@ -0,0 +1,30 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef INDEX_SEQUENCE_H
+#define INDEX_SEQUENCE_H
+
+#include <Arduino.h>
+
+// Minimal std::integer_sequence stand-in, since the AVR toolchain has no standard library. Used to expand constexpr
+// functions into PROGMEM lookup tables.
+template <uint16_t... Is> struct IndexSequence {};
+template <uint16_t N, uint16_t... Is> struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Is...> {};
+template <uint16_t... Is> struct MakeIndexSequence<0, Is...> {
+  typedef IndexSequence<Is...> Type;
+};
+
+#endif
@@ -0,0 +1,215 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef IO_LAYOUT_H
+#define IO_LAYOUT_H
+
+#include <Arduino.h>
+
+#include "index_sequence.h"
+
+// Where each module's motor phases and home sensor (and on chainlink boards, its LED and the loopback test bits) sit in
+// motor_buffer and sensor_buffer. Everything is computed by the constexpr functions below, and expanded per chain
+// length into PROGMEM tables by IoLayout::Layout so that nothing is divided out at runtime.
+//
+// motor_buffer is shifted out last byte first, so module 0 is at its end. A classic driver board takes one nibble of
+// motor_buffer and one bit of sensor_buffer per module, in order (4 sensors to a byte). A chainlink board b (modules 6b
+// to 6b+5) takes 4 motor bytes, counting back from the end of the buffer by 4b:
+//     end - 0: module 0 (bits 0-3), module 1 (bits 4-7)
+//     end - 1: module 2 (bits 0-3), LEDs 0-2 (bits 4-6), loopback 0 out (bit 7)
+//     end - 2: LEDs 3-5 (bits 0-2), loopback 1 out (bit 3), module 3 (bits 4-7)
+//     end - 3: module 4 (bits 0-3), module 5 (bits 4-7)
+// and sensor byte b: home sensors 0-5 (bits 0-5), loopback 0 in (bit 6), loopback 1 in (bit 7).
+//
+// A display can also be split into two chains, each shifted out separately (see SPI_IO_SPLIT_CHAIN): modules 0 to
+// SPLIT-1 on the first and the rest on the second. Each chain is laid out as above on its own, and gets its own region
+// of each buffer. The second chain's motor bytes start at the next word boundary, for DMA; its sensor bytes follow
+// straight on, which keeps module i at bit i % SENSOR_MODULES_PER_BYTE of sensor byte i / SENSOR_MODULES_PER_BYTE as
+// long as SPLIT is a whole number of sensor bytes.
+namespace IoLayout {
+    struct ModuleIo {
+        uint8_t motor_byte;
+        uint8_t motor_bitshift;
+        uint8_t sensor_byte;
+        uint8_t sensor_bitmask;
+    };
+
+    struct BufferBit {
+        uint8_t byte;
+        uint8_t bitmask;
+    };
+
+    struct LoopbackIo {
+        BufferBit out;  // in motor_buffer
+        BufferBit in;   // in sensor_buffer
+    };
+
+    constexpr uint8_t MotorBufferLength(uint8_t num_modules, bool chainlink) {
+        return chainlink
+            ? num_modules * 2 / 3 + (num_modules % 3 != 0) * 2
+            : num_modules / 2 + (num_modules % 2 != 0);
+    }
+
+    constexpr uint8_t SensorBufferLength(uint8_t num_modules, bool chainlink) {
+        return chainlink
+            ? num_modules / 6 + (num_modules % 6 != 0)
+            : num_modules / 4 + (num_modules % 4 != 0);
+    }
+
+    constexpr uint8_t ChainlinkMotorByte(uint8_t num_modules, uint8_t board, uint8_t offset) {
+        return MotorBufferLength(num_modules, true) - 1 - board * 4 - offset;
+    }
+
+    constexpr uint8_t ChainlinkModuleOffset(uint8_t board_position) {
+        return board_position < 2 ? 0 : board_position < 4 ? board_position - 1 : 3;
+    }
+
+    constexpr ModuleIo Module(uint8_t num_modules, bool chainlink, uint8_t i) {
+        return chainlink
+            ? ModuleIo {
+                ChainlinkMotorByte(num_modules, i / 6, ChainlinkModuleOffset(i % 6)),
+                (uint8_t)(i % 2 == 0 ? 0 : 4),
+                (uint8_t)(i / 6),
+                (uint8_t)(1 << (i % 6)),
+            }
+            : ModuleIo {
+                (uint8_t)(MotorBufferLength(num_modules, false) - 1 - i / 2),
+                (uint8_t)(i % 2 == 0 ? 0 : 4),
+                (uint8_t)(i / 4),
+                (uint8_t)(1 << (i % 4)),
+            };
+    }
+
+    // Start of the second chain's region of motor_buffer, for a split after `split` modules
+    constexpr uint8_t SplitMotorOffset(uint8_t split, bool chainlink) {
+        return (MotorBufferLength(split, chainlink) + 3) & ~3;
+    }
+
+    constexpr ModuleIo OffsetModule(ModuleIo io, uint8_t motor_offset, uint8_t sensor_offset) {
+        return ModuleIo {
+            (uint8_t)(io.motor_byte + motor_offset),
+            io.motor_bitshift,
+            (uint8_t)(io.sensor_byte + sensor_offset),
+            io.sensor_bitmask,
+        };
+    }
+
+    // Module i of num_modules split into two chains after `split` modules (split == num_modules for a single chain)
+    constexpr ModuleIo SplitModule(uint8_t num_modules, bool chainlink, uint8_t split, uint8_t i) {
+        return i < split
+            ? Module(split, chainlink, i)
+            : OffsetModule(Module(num_modules - split, chainlink, i - split),
+                SplitMotorOffset(split, chainlink), SensorBufferLength(split, chainlink));
+    }
+
+    constexpr BufferBit ChainlinkLed(uint8_t num_modules, uint8_t i) {
+        return i % 6 < 3
+            ? BufferBit { ChainlinkMotorByte(num_modules, i / 6, 1), (uint8_t)(1 << (4 + i % 6)) }
+            : BufferBit { ChainlinkMotorByte(num_modules, i / 6, 2), (uint8_t)(1 << (i % 6 - 3)) };
+    }
+
+    constexpr LoopbackIo ChainlinkLoopback(uint8_t num_modules, uint8_t loopback) {
+        return loopback % 2 == 0
+            ? LoopbackIo {
+                { ChainlinkMotorByte(num_modules, loopback / 2, 1), 1 << 7 },
+                { (uint8_t)(loopback / 2), 1 << 6 },
+            }
+            : LoopbackIo {
+                { ChainlinkMotorByte(num_modules, loopback / 2, 2), 1 << 3 },
+                { (uint8_t)(loopback / 2), 1 << 7 },
+            };
+    }
+
+    constexpr BufferBit OffsetBufferBit(BufferBit bit, uint8_t offset) {
+        return BufferBit { (uint8_t)(bit.byte + offset), bit.bitmask };
+    }
+
+    constexpr BufferBit SplitChainlinkLed(uint8_t num_modules, uint8_t split, uint8_t i) {
+        return i < split
+            ? ChainlinkLed(split, i)
+            : OffsetBufferBit(ChainlinkLed(num_modules - split, i - split), SplitMotorOffset(split, true));
+    }
+
+    constexpr LoopbackIo SplitChainlinkLoopback(uint8_t num_modules, uint8_t split, uint8_t loopback) {
+        return loopback < split / 3
+            ? ChainlinkLoopback(split, loopback)
+            : LoopbackIo {
+                OffsetBufferBit(ChainlinkLoopback(num_modules - split, loopback - split / 3).out, SplitMotorOffset(split, true)),
+                OffsetBufferBit(ChainlinkLoopback(num_modules - split, loopback - split / 3).in, SensorBufferLength(split, true)),
+            };
+    }
+
+    inline BufferBit ReadBufferBit(const BufferBit* entry) {
+        return BufferBit { pgm_read_byte_near(&entry->byte), pgm_read_byte_near(&entry->bitmask) };
+    }
+
+    // Tables for a chain of NUM modules, split after SPLIT of them. The LED and loopback tables are only instantiated
+    // (and only meaningful) for chainlink boards.
+    template <uint8_t NUM, bool CHAINLINK_BOARDS, uint8_t SPLIT = NUM,
+        class Modules = typename MakeIndexSequence<NUM>::Type,
+        class Loopbacks = typename MakeIndexSequence<NUM / 3>::Type>
+    struct Layout;
+
+    template <uint8_t NUM, bool CHAINLINK_BOARDS, uint8_t SPLIT, uint16_t... Ms, uint16_t... Ls>
+    struct Layout<NUM, CHAINLINK_BOARDS, SPLIT, IndexSequence<Ms...>, IndexSequence<Ls...>> {
+        static_assert(SPLIT > 0 && SPLIT <= NUM, "SPLIT must leave modules on the first chain");
+        static_assert(SPLIT == NUM || SPLIT % (CHAINLINK_BOARDS ? 6 : 4) == 0,
+            "SPLIT must be a whole number of sensor bytes (6 modules on chainlink boards, 4 otherwise)");
+
+        static const uint8_t MOTOR_BUFFER_LENGTH = SPLIT < NUM
+            ? SplitMotorOffset(SPLIT, CHAINLINK_BOARDS) + MotorBufferLength(NUM - SPLIT, CHAINLINK_BOARDS)
+            : MotorBufferLength(NUM, CHAINLINK_BOARDS);
+        static const uint8_t SENSOR_BUFFER_LENGTH = SensorBufferLength(NUM, CHAINLINK_BOARDS);
+
+        static const ModuleIo MODULES[NUM];
+        static const BufferBit LEDS[NUM];
+        static const LoopbackIo LOOPBACKS[sizeof...(Ls) > 0 ? sizeof...(Ls) : 1];
+
+        static inline ModuleIo Module(uint8_t i) {
+            return ModuleIo {
+                pgm_read_byte_near(&MODULES[i].motor_byte),
+                pgm_read_byte_near(&MODULES[i].motor_bitshift),
+                pgm_read_byte_near(&MODULES[i].sensor_byte),
+                pgm_read_byte_near(&MODULES[i].sensor_bitmask),
+            };
+        }
+
+        static inline BufferBit Led(uint8_t i) {
+            return ReadBufferBit(&LEDS[i]);
+        }
+
+        static inline LoopbackIo Loopback(uint8_t loopback) {
+            return LoopbackIo { ReadBufferBit(&LOOPBACKS[loopback].out), ReadBufferBit(&LOOPBACKS[loopback].in) };
+        }
+    };
+
+    template <uint8_t NUM, bool CHAINLINK_BOARDS, uint8_t SPLIT, uint16_t... Ms, uint16_t... Ls>
+    const ModuleIo Layout<NUM, CHAINLINK_BOARDS, SPLIT, IndexSequence<Ms...>, IndexSequence<Ls...>>::MODULES[NUM] PROGMEM = {
+        SplitModule(NUM, CHAINLINK_BOARDS, SPLIT, Ms)...
+    };
+
+    template <uint8_t NUM, bool CHAINLINK_BOARDS, uint8_t SPLIT, uint16_t... Ms, uint16_t... Ls>
+    const BufferBit Layout<NUM, CHAINLINK_BOARDS, SPLIT, IndexSequence<Ms...>, IndexSequence<Ls...>>::LEDS[NUM] PROGMEM = {
+        SplitChainlinkLed(NUM, SPLIT, Ms)...
+    };
+
+    template <uint8_t NUM, bool CHAINLINK_BOARDS, uint8_t SPLIT, uint16_t... Ms, uint16_t... Ls>
+    const LoopbackIo Layout<NUM, CHAINLINK_BOARDS, SPLIT, IndexSequence<Ms...>, IndexSequence<Ls...>>::LOOPBACKS[sizeof...(Ls) > 0 ? sizeof...(Ls) : 1] PROGMEM = {
+        SplitChainlinkLoopback(NUM, SPLIT, Ls)...
+    };
+}
+
+#endif
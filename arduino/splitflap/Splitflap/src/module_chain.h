@@ -0,0 +1,289 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef MODULE_CHAIN_H
+#define MODULE_CHAIN_H
+
+#include "io_layout.h"
+#include "sensor_debounce.h"
+#include "sensor_edge_latch.h"
+#include "splitflap_module.h"
+
+// The parts of a shift register IO backend that don't depend on how the buffers reach the chain: motor_buffer and
+// sensor_buffer (laid out as in io_layout.h), the modules[] driving them, and the chainlink LED and loopback helpers.
+//
+// A backend (spi_io_config.h, virtual_io_config.h) defines BUFFER_ATTRS and MOTOR_SENSOR_IO_ROUND_TRIP (and, if it
+// drives the modules as two chains, MODULE_CHAIN_SPLIT: the number of modules on the first), includes this header, and
+// then defines:
+//   initialize_modules()    calls initialize_module_chain() and sets up the hardware
+//   motor_sensor_io()       shifts motor_buffer out to the chain and the home sensors (and loopbacks) into sensor_buffer
+//                           and calls sensor_frame_received() once they've landed there
+//   motor_sensor_io_wait()  finishes any motor_sensor_io() still in flight
+//   motor_sensor_io_set_clock(clock_hz)
+//                           (optional, for SPI_CLOCK_CALIBRATION) changes the clock the chain is shifted at
+// SplitflapTask and Splitflap.ino use nothing else, so a new board type only needs a new backend. Boards with the
+// modules wired straight to pins use basic_io_config.h instead.
+
+inline void motor_sensor_io();
+
+#ifndef MODULE_CHAIN_SPLIT
+#define MODULE_CHAIN_SPLIT NUM_MODULES
+#endif
+
+// Home sensor inputs occupy the low SENSOR_MODULES_PER_BYTE bits of each sensor_buffer byte
+#ifdef CHAINLINK
+#define SENSOR_MODULES_PER_BYTE 6
+typedef IoLayout::Layout<NUM_MODULES, true, MODULE_CHAIN_SPLIT> ChainIoLayout;
+#else
+#define SENSOR_MODULES_PER_BYTE 4
+typedef IoLayout::Layout<NUM_MODULES, false, MODULE_CHAIN_SPLIT> ChainIoLayout;
+#endif
+#define MOTOR_BUFFER_LENGTH (ChainIoLayout::MOTOR_BUFFER_LENGTH)
+#define SENSOR_BUFFER_LENGTH (ChainIoLayout::SENSOR_BUFFER_LENGTH)
+
+BUFFER_ATTRS uint8_t motor_buffer[MOTOR_BUFFER_LENGTH];
+BUFFER_ATTRS uint8_t sensor_buffer[SENSOR_BUFFER_LENGTH];
+
+#if SENSOR_DEBOUNCE_FRAMES > 1
+SensorDebounce<SENSOR_BUFFER_LENGTH, SENSOR_DEBOUNCE_FRAMES, SENSOR_MODULES_PER_BYTE> sensor_debounce;
+#endif
+
+#if SENSOR_EDGE_LATCH
+// Rising edges on each sensor_buffer input not yet consumed by CheckSensor(), and the inputs from the frame before
+// (see sensor_edge_latch.h)
+BUFFER_ATTRS uint8_t sensor_edges[SENSOR_BUFFER_LENGTH];
+BUFFER_ATTRS uint8_t sensor_last[SENSOR_BUFFER_LENGTH];
+#endif
+
+// Post-processes each frame of inputs read into sensor_buffer: filters glitches out of the home sensors
+// (SENSOR_DEBOUNCE_FRAMES), then latches their rising edges for CheckSensor() (SENSOR_EDGE_LATCH)
+inline void sensor_frame_received() {
+#if SENSOR_DEBOUNCE_FRAMES > 1
+  sensor_debounce.Filter(sensor_buffer);
+#endif
+#if SENSOR_EDGE_LATCH
+  LatchSensorEdges(sensor_buffer, sensor_last, sensor_edges, SENSOR_BUFFER_LENGTH);
+#endif
+}
+
+#ifdef __AVR__
+// Define placement new so we can initialize SplitflapModules at runtime into a static buffer.
+// (see https://arduino.stackexchange.com/a/1499)
+void* operator new(__attribute__((unused)) size_t size, void* ptr) {
+  return ptr;
+}
+#endif
+
+#if BATCH_STEPPING
+#include "splitflap_batch.h"
+
+typedef SplitflapBatchModuleT<NUM_MODULES> SplitflapBatchModule;
+
+#if SENSOR_EDGE_LATCH
+SplitflapBatch<NUM_MODULES> splitflap_batch(motor_buffer, sensor_buffer, sensor_edges);
+#else
+SplitflapBatch<NUM_MODULES> splitflap_batch(motor_buffer, sensor_buffer);
+#endif
+
+// Static buffer for per-module views of splitflap_batch (initialized at runtime)
+static char moduleBuffer[NUM_MODULES][sizeof(SplitflapBatchModule)];
+
+SplitflapBatchModule* modules[NUM_MODULES];
+#else
+// Static buffer for SplitflapModules (initialized at runtime)
+static char moduleBuffer[NUM_MODULES][sizeof(SplitflapModule)];
+
+SplitflapModule* modules[NUM_MODULES];
+#endif
+
+inline void initialize_module_chain() {
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    IoLayout::ModuleIo io = ChainIoLayout::Module(i);
+
+    // Create SplitflapModules in a statically allocated buffer using placement new
+#if BATCH_STEPPING
+    splitflap_batch.AttachModule(i, io.motor_byte, io.motor_bitshift, io.sensor_byte, io.sensor_bitmask);
+    modules[i] = new (moduleBuffer[i]) SplitflapBatchModule(splitflap_batch, i);
+#elif SENSOR_EDGE_LATCH
+    modules[i] = new (moduleBuffer[i]) SplitflapModule(motor_buffer[io.motor_byte], io.motor_bitshift, sensor_buffer[io.sensor_byte], io.sensor_bitmask, sensor_edges[io.sensor_byte]);
+#else
+    modules[i] = new (moduleBuffer[i]) SplitflapModule(motor_buffer[io.motor_byte], io.motor_bitshift, sensor_buffer[io.sensor_byte], io.sensor_bitmask);
+#endif
+  }
+
+  memset(motor_buffer, 0, MOTOR_BUFFER_LENGTH);
+  memset(sensor_buffer, 0, SENSOR_BUFFER_LENGTH);
+#if SENSOR_EDGE_LATCH
+  memset(sensor_edges, 0, SENSOR_BUFFER_LENGTH);
+  memset(sensor_last, 0, SENSOR_BUFFER_LENGTH);
+#endif
+}
+
+#ifdef CHAINLINK
+void chainlink_set_led(uint8_t moduleIndex, bool on) {
+  IoLayout::BufferBit led = ChainIoLayout::Led(moduleIndex);
+  if (on) {
+    motor_buffer[led.byte] |= led.bitmask;
+  } else {
+    motor_buffer[led.byte] &= ~led.bitmask;
+  }
+}
+
+bool chainlink_test_startup_loopback(bool results[NUM_LOOPBACKS]) {
+    bool success = true;
+
+    // Turn off all motors, leds, and loopbacks; make sure all loopback inputs read 0
+    memset(motor_buffer, 0, MOTOR_BUFFER_LENGTH);
+    for (uint8_t i = 0; i < MOTOR_SENSOR_IO_ROUND_TRIP; i++) {
+      motor_sensor_io();
+    }
+
+    for (uint8_t i = 0; i < NUM_LOOPBACKS; i++) {
+      IoLayout::BufferBit loop_in = ChainIoLayout::Loopback(i).in;
+      results[i] = (sensor_buffer[loop_in.byte] & loop_in.bitmask) == 0;
+      success &= results[i];
+    }
+    return success;
+}
+
+void chainlink_set_loopback(uint8_t loop_out_index) {
+    // Turn on loopback output
+    IoLayout::BufferBit loop_out = ChainIoLayout::Loopback(loop_out_index).out;
+    motor_buffer[loop_out.byte] |= loop_out.bitmask;
+}
+
+/**
+ * Validate that the loopback from loop_out_index can be read successfully. There must be AT LEAST MOTOR_SENSOR_IO_ROUND_TRIP
+ * motor_sensor_io() invocations between setting the loopback and validating it - one for turning on the shift register output and
+ * another to read in the shift register input (plus, with SPI_IO_ASYNC, one to collect that read).
+ */
+bool chainlink_validate_loopback(uint8_t loop_out_index, bool results[NUM_LOOPBACKS]) {
+    bool success = true;
+    for (uint8_t loop_in_index = 0; loop_in_index < NUM_LOOPBACKS; loop_in_index++) {
+      IoLayout::BufferBit loop_in = ChainIoLayout::Loopback(loop_in_index).in;
+      uint8_t expected_bit_mask = (loop_out_index == loop_in_index) ? loop_in.bitmask : 0;
+      uint8_t actual_bit_mask = sensor_buffer[loop_in.byte] & loop_in.bitmask;
+
+      bool ok = actual_bit_mask == expected_bit_mask;
+      success &= ok;
+      if (results != nullptr) {
+        results[loop_in_index] = ok;
+      }
+    }
+
+    // Turn off loopback output
+    IoLayout::BufferBit loop_out = ChainIoLayout::Loopback(loop_out_index).out;
+    motor_buffer[loop_out.byte] &= ~loop_out.bitmask;
+    return success;
+}
+
+/**
+ * Shifts `frames` pseudo-random patterns out through the loopback outputs (from an xorshift generator started at seed,
+ * which must not be 0), waiting MOTOR_SENSOR_IO_ROUND_TRIP motor_sensor_io() invocations for each, and returns how many
+ * of them didn't read back exactly on the loopback inputs. Leaves all outputs off.
+ */
+uint16_t chainlink_test_loopback_patterns(uint16_t frames, uint32_t seed) {
+    uint16_t errors = 0;
+    uint32_t random = seed;
+    memset(motor_buffer, 0, MOTOR_BUFFER_LENGTH);
+    for (uint16_t frame = 0; frame < frames; frame++) {
+      for (uint8_t i = 0; i < NUM_LOOPBACKS; i++) {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        IoLayout::BufferBit loop_out = ChainIoLayout::Loopback(i).out;
+        if (random & 1) {
+          motor_buffer[loop_out.byte] |= loop_out.bitmask;
+        } else {
+          motor_buffer[loop_out.byte] &= ~loop_out.bitmask;
+        }
+      }
+      for (uint8_t i = 0; i < MOTOR_SENSOR_IO_ROUND_TRIP; i++) {
+        motor_sensor_io();
+      }
+
+      bool ok = true;
+      for (uint8_t i = 0; i < NUM_LOOPBACKS; i++) {
+        IoLayout::LoopbackIo loopback = ChainIoLayout::Loopback(i);
+        ok &= ((motor_buffer[loopback.out.byte] & loopback.out.bitmask) != 0)
+            == ((sensor_buffer[loopback.in.byte] & loopback.in.bitmask) != 0);
+      }
+      errors += !ok;
+    }
+    memset(motor_buffer, 0, MOTOR_BUFFER_LENGTH);
+    return errors;
+}
+
+#if CODED_LOOPBACKS
+// Loopback output l in coded pattern p is bit p / 2 of l, inverted when p is odd. Over the cycle of
+// CHAINLINK_LOOPBACK_PATTERNS patterns every loopback is driven both high and low, and any two loopbacks are driven to
+// opposite levels both ways round, so a stuck, open, shorted or crossed loopback reads back wrong at least once.
+constexpr uint8_t chainlink_loopback_index_bits(uint8_t num_loopbacks) {
+    return num_loopbacks <= 2 ? 1 : 1 + chainlink_loopback_index_bits((num_loopbacks + 1) / 2);
+}
+
+#define CHAINLINK_LOOPBACK_PATTERNS (2 * chainlink_loopback_index_bits(NUM_LOOPBACKS))
+
+inline bool chainlink_loopback_pattern_bit(uint8_t pattern, uint8_t loopback) {
+    return ((loopback >> (pattern / 2)) & 1) ^ (pattern & 1);
+}
+
+void chainlink_set_loopback_pattern(uint8_t pattern) {
+    for (uint8_t i = 0; i < NUM_LOOPBACKS; i++) {
+      IoLayout::BufferBit loop_out = ChainIoLayout::Loopback(i).out;
+      if (chainlink_loopback_pattern_bit(pattern, i)) {
+        motor_buffer[loop_out.byte] |= loop_out.bitmask;
+      } else {
+        motor_buffer[loop_out.byte] &= ~loop_out.bitmask;
+      }
+    }
+}
+
+/**
+ * Checks every loopback input against pattern, which must have been set AT LEAST MOTOR_SENSOR_IO_ROUND_TRIP
+ * motor_sensor_io() invocations ago. Returns the first loopback that reads back wrong, or NUM_LOOPBACKS if none do.
+ */
+uint8_t chainlink_check_loopback_pattern(uint8_t pattern) {
+    for (uint8_t i = 0; i < NUM_LOOPBACKS; i++) {
+      IoLayout::BufferBit loop_in = ChainIoLayout::Loopback(i).in;
+      if (((sensor_buffer[loop_in.byte] & loop_in.bitmask) != 0) != chainlink_loopback_pattern_bit(pattern, i)) {
+        return i;
+      }
+    }
+    return NUM_LOOPBACKS;
+}
+#endif
+
+bool chainlink_test_all_loopbacks(bool loopback_result[NUM_LOOPBACKS][NUM_LOOPBACKS], bool loopback_off_result[NUM_LOOPBACKS]) {
+    bool loopback_success = true;
+
+    // Turn one loopback bit on at a time and make sure only that loopback bit is set
+    for (uint8_t loop_out_index = 0; loop_out_index < NUM_LOOPBACKS; loop_out_index++) {
+      chainlink_set_loopback(loop_out_index);
+      for (uint8_t i = 0; i < MOTOR_SENSOR_IO_ROUND_TRIP; i++) {
+        motor_sensor_io();
+      }
+      loopback_success &= chainlink_validate_loopback(loop_out_index, loopback_result[loop_out_index]);
+    }
+
+    loopback_success &= chainlink_test_startup_loopback(loopback_off_result);
+
+    return loopback_success;
+}
+
+#endif
+
+#endif
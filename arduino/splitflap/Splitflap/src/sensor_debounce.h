@@ -0,0 +1,102 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SENSOR_DEBOUNCE_H
+#define SENSOR_DEBOUNCE_H
+
+#include <Arduino.h>
+
+#include <string.h>
+
+// Glitch filter for the home sensor inputs of a whole sensor_buffer (see SENSOR_DEBOUNCE_FRAMES). An input only
+// changes in the filtered buffer once it has read the new level on DEPTH frames in a row, so a blip shorter than that
+// never reaches the modules.
+//
+// Every input has its own counter of consecutive frames it has disagreed with its filtered level, but the counters
+// are stored "vertically": bit k of every counter in a word of the buffer is held together in count_[k], so a frame
+// is filtered with a handful of bitwise operations per 32 inputs, however long the chain. Only the low SENSOR_BITS of
+// each byte (the home sensors) are filtered; the other bits (the chainlink loopback inputs) pass straight through, so
+// the loopback tests still see every frame exactly.
+template <uint8_t LENGTH, uint8_t DEPTH, uint8_t SENSOR_BITS>
+class SensorDebounce {
+ public:
+  static_assert(DEPTH >= 1 && DEPTH <= 16, "DEPTH must be between 1 and 16 frames");
+
+  SensorDebounce() {
+    memset(state_, 0, sizeof(state_));
+    memset(count_, 0, sizeof(count_));
+  }
+
+  // Replaces the frame just read into sensors with its filtered version. The first frame is taken as it is, since
+  // there's nothing yet to filter it against; otherwise a module powered up over its home flag would see a late rising
+  // edge once it had already started homing.
+  void Filter(uint8_t* sensors) {
+    uint32_t raw;
+    for (uint8_t w = 0; w < LENGTH / 4; w++) {
+      memcpy(&raw, &sensors[w * 4], 4);
+      raw = FilterWord(w, raw);
+      memcpy(&sensors[w * 4], &raw, 4);
+    }
+    if (LENGTH % 4 != 0) {
+      raw = 0;
+      memcpy(&raw, &sensors[LENGTH / 4 * 4], LENGTH % 4);
+      raw = FilterWord(LENGTH / 4, raw);
+      memcpy(&sensors[LENGTH / 4 * 4], &raw, LENGTH % 4);
+    }
+    primed_ = true;
+  }
+
+ private:
+  static constexpr uint8_t CounterBits(uint8_t max_count) {
+    return max_count <= 1 ? 1 : 1 + CounterBits(max_count >> 1);
+  }
+
+  static const uint8_t WORDS = (LENGTH + 3) / 4;
+  static const uint8_t COUNTER_BITS = CounterBits(DEPTH - 1);
+  static const uint32_t SENSOR_MASK = ((1u << SENSOR_BITS) - 1) * 0x01010101u;
+
+  inline uint32_t FilterWord(uint8_t w, uint32_t raw) {
+    if (!primed_) {
+      state_[w] = raw & SENSOR_MASK;
+    }
+
+    // Inputs reading differently from their filtered level, and those among them for which this is the DEPTH'th
+    // frame in a row (their counter already reads DEPTH - 1)
+    uint32_t delta = (raw ^ state_[w]) & SENSOR_MASK;
+    uint32_t settled = delta;
+    for (uint8_t k = 0; k < COUNTER_BITS; k++) {
+      settled &= ((DEPTH - 1) >> k) & 1 ? count_[k][w] : ~count_[k][w];
+    }
+    state_[w] ^= settled;
+
+    // Count up where the input still disagrees, and clear the rest
+    uint32_t carry = delta;
+    uint32_t keep = delta & ~settled;
+    for (uint8_t k = 0; k < COUNTER_BITS; k++) {
+      uint32_t bit = count_[k][w];
+      count_[k][w] = (bit ^ carry) & keep;
+      carry &= bit;
+    }
+
+    return (raw & ~SENSOR_MASK) | state_[w];
+  }
+
+  uint32_t state_[WORDS];  // Filtered level of each home sensor input
+  uint32_t count_[COUNTER_BITS][WORDS];
+  bool primed_ = false;
+};
+
+#endif
@@ -0,0 +1,48 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SENSOR_EDGE_LATCH_H
+#define SENSOR_EDGE_LATCH_H
+
+#include <Arduino.h>
+
+#include <string.h>
+
+// With SENSOR_EDGE_LATCH, this is run on every frame that lands in sensor_buffer (see sensor_frame_received() in
+// module_chain.h). It ORs each input's rising edges since the previous frame (against `last`, which it then updates)
+// into `edges`, where they stay until CheckSensor() consumes them. A home blip shorter than a step therefore still
+// registers at the module's next step, rather than only if it happens to be high on the frame that step samples.
+//
+// The buffers are worked through four bytes at a time; memcpy keeps that free of alignment and aliasing trouble and
+// compiles down to plain word loads and stores.
+inline void LatchSensorEdges(const uint8_t* sensors, uint8_t* last, uint8_t* edges, uint8_t length) {
+  uint8_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    uint32_t cur_word, last_word, edge_word;
+    memcpy(&cur_word, &sensors[i], 4);
+    memcpy(&last_word, &last[i], 4);
+    memcpy(&edge_word, &edges[i], 4);
+    edge_word |= cur_word & ~last_word;
+    memcpy(&edges[i], &edge_word, 4);
+    memcpy(&last[i], &cur_word, 4);
+  }
+  for (; i < length; i++) {
+    edges[i] |= sensors[i] & ~last[i];
+    last[i] = sensors[i];
+  }
+}
+
+#endif
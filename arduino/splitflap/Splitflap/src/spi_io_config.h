@@ -78,104 +78,200 @@
   #define SPI_HOST HSPI_HOST
   #define DMA_CHANNEL 1
 
+#if SPI_IO_SPLIT_CHAIN
+  #if ENABLE_DISPLAY
+  #error "SPI_IO_SPLIT_CHAIN drives the second chain from VSPI, which the display uses (build with -DENABLE_DISPLAY=false)"
+  #endif
+
+  // Second chain (modules SPI_IO_SPLIT_MODULES and up). The defaults are pins a T-Display (and the chainlink base
+  // board around it) leaves free.
+  #ifndef LATCH_PIN_2
+  #define LATCH_PIN_2 (13)
+  #endif
+  #ifndef PIN_NUM_MISO_2
+  #define PIN_NUM_MISO_2 38
+  #endif
+  #ifndef PIN_NUM_MOSI_2
+  #define PIN_NUM_MOSI_2 2
+  #endif
+  #ifndef PIN_NUM_CLK_2
+  #define PIN_NUM_CLK_2 15
+  #endif
+
+  #define SPI_HOST_2 VSPI_HOST
+  #define DMA_CHANNEL_2 2
+
+  #define SPI_IO_CHAINS 2
+  #define MODULE_CHAIN_SPLIT SPI_IO_SPLIT_MODULES
+#else
+  #define SPI_IO_CHAINS 1
+#endif
 
-  spi_device_handle_t spi_tx;
-  spi_device_handle_t spi_rx;
+  // Pins and bus of each chain
+  struct SpiChain {
+    spi_host_device_t host;
+    int dma_channel;
+    int latch_pin;
+    int miso_pin;
+    int mosi_pin;
+    int clk_pin;
+  };
 
-  spi_transaction_t tx_transaction;
-  spi_transaction_t rx_transaction;
+  const SpiChain SPI_CHAINS[SPI_IO_CHAINS] = {
+    {SPI_HOST, DMA_CHANNEL, LATCH_PIN, PIN_NUM_MISO, PIN_NUM_MOSI, PIN_NUM_CLK},
+#if SPI_IO_SPLIT_CHAIN
+    {SPI_HOST_2, DMA_CHANNEL_2, LATCH_PIN_2, PIN_NUM_MISO_2, PIN_NUM_MOSI_2, PIN_NUM_CLK_2},
+#endif
+  };
 
+  // One of each per chain. With SPI_IO_FULL_DUPLEX, spi_tx/tx_transaction also read the sensor inputs and there's no
+  // separate read. Each transaction's user field holds its chain's index, for the latch callbacks.
+  spi_device_handle_t spi_tx[SPI_IO_CHAINS];
+  spi_transaction_t tx_transaction[SPI_IO_CHAINS];
+#if !SPI_IO_FULL_DUPLEX
+  spi_device_handle_t spi_rx[SPI_IO_CHAINS];
+  spi_transaction_t rx_transaction[SPI_IO_CHAINS];
+#endif
 
+#else
+#if SPI_IO_SPLIT_CHAIN
+#error "SPI_IO_SPLIT_CHAIN is only supported on ESP32"
+#endif
 #endif
 
 #if !defined(__AVR_ATmega168__) && !defined(__AVR_ATmega328P__) && !defined(ARDUINO_ESP8266_WEMOS_D1MINI) && !defined(ESP32)
 #error "Unknown/unsupported board for SPI mode. ATmega328-based boards (Uno, Duemilanove, Diecimila), ESP8266 and ESP32 are currently supported"
 #endif
 
-#ifdef CHAINLINK
-#define MOTOR_BUFFER_LENGTH (NUM_MODULES * 2 / 3 + (NUM_MODULES % 3 != 0) * 2)
-#define SENSOR_BUFFER_LENGTH (NUM_MODULES / 6 + (NUM_MODULES % 6 != 0))
+#if defined(ESP32) && SPI_IO_ASYNC
+// Number of motor_sensor_io() calls before an output change shows up in sensor_buffer (e.g. through a chainlink
+// loopback): one to latch the output, one to read the input back in, and one more to collect that read.
+#define MOTOR_SENSOR_IO_ROUND_TRIP 3
 #else
-#define MOTOR_BUFFER_LENGTH (NUM_MODULES / 2 + (NUM_MODULES % 2 != 0))
-#define SENSOR_BUFFER_LENGTH (NUM_MODULES / 4 + (NUM_MODULES % 4 != 0))
+#define MOTOR_SENSOR_IO_ROUND_TRIP 2
 #endif
 
-
-BUFFER_ATTRS uint8_t motor_buffer[MOTOR_BUFFER_LENGTH];
-BUFFER_ATTRS uint8_t sensor_buffer[SENSOR_BUFFER_LENGTH];
-
-#ifdef __AVR__
-// Define placement new so we can initialize SplitflapModules at runtime into a static buffer.
-// (see https://arduino.stackexchange.com/a/1499)
-void* operator new(__attribute__((unused)) size_t size, void* ptr) {
-  return ptr;
-}
-#endif
+#include "module_chain.h"
 
 #ifdef ESP32
-void reset_latch(spi_transaction_t *trans) {
-    digitalWrite(LATCH_PIN, LOW);
-}
-
-void latch_registers(spi_transaction_t *trans) {
-    digitalWrite(LATCH_PIN, HIGH);
-}
+// Each chain's share of the buffers: its motor bytes, its sensor bytes, and where in sensor_frame its inputs are read to
+struct SpiChainBuffers {
+  uint8_t motor_offset;
+  uint8_t motor_length;
+  uint8_t sensor_offset;
+  uint8_t sensor_length;
+  uint8_t frame_offset;
+};
+
+#define _SPI_DMA_LENGTH(length) (((length) + 3) & ~3)
+#if SPI_IO_FULL_DUPLEX
+// A full-duplex frame clocks in as many bytes as it clocks out, of which the sensor inputs are the first ones
+#define _SPI_FRAME_LENGTH(modules) IoLayout::MotorBufferLength(modules, SENSOR_MODULES_PER_BYTE == 6)
+#else
+#define _SPI_FRAME_LENGTH(modules) IoLayout::SensorBufferLength(modules, SENSOR_MODULES_PER_BYTE == 6)
 #endif
 
-// Static buffer for SplitflapModules (initialized at runtime)
-static char moduleBuffer[NUM_MODULES][sizeof(SplitflapModule)];
-
-SplitflapModule* modules[NUM_MODULES];
+constexpr SpiChainBuffers SPI_CHAIN_BUFFERS[SPI_IO_CHAINS] = {
+  {
+    0,
+    IoLayout::MotorBufferLength(MODULE_CHAIN_SPLIT, SENSOR_MODULES_PER_BYTE == 6),
+    0,
+    IoLayout::SensorBufferLength(MODULE_CHAIN_SPLIT, SENSOR_MODULES_PER_BYTE == 6),
+    0,
+  },
+#if SPI_IO_SPLIT_CHAIN
+  {
+    IoLayout::SplitMotorOffset(MODULE_CHAIN_SPLIT, SENSOR_MODULES_PER_BYTE == 6),
+    IoLayout::MotorBufferLength(NUM_MODULES - MODULE_CHAIN_SPLIT, SENSOR_MODULES_PER_BYTE == 6),
+    IoLayout::SensorBufferLength(MODULE_CHAIN_SPLIT, SENSOR_MODULES_PER_BYTE == 6),
+    IoLayout::SensorBufferLength(NUM_MODULES - MODULE_CHAIN_SPLIT, SENSOR_MODULES_PER_BYTE == 6),
+    _SPI_DMA_LENGTH(_SPI_FRAME_LENGTH(MODULE_CHAIN_SPLIT)),
+  },
+#endif
+};
+#endif
 
-#ifdef CHAINLINK
-static const uint8_t MOTOR_OFFSET[] = {0, 0, 1, 2, 3, 3};
+#if defined(ESP32) && (SPI_IO_ASYNC || SPI_IO_SPLIT_CHAIN)
+bool frame_in_flight = false;
 #endif
 
-inline void initialize_modules() {
-  for (uint8_t i = 0; i < NUM_MODULES; i++) {
-    // Create SplitflapModules in a statically allocated buffer using placement new
-#ifdef CHAINLINK
-    modules[i] = new (moduleBuffer[i]) SplitflapModule(motor_buffer[MOTOR_BUFFER_LENGTH - 1 - i/6*4 - MOTOR_OFFSET[i%6]], i % 2 == 0 ? 0 : 4, sensor_buffer[i/6], 1 << (i % 6));
+#if defined(ESP32) && (SPI_IO_ASYNC || SPI_IO_FULL_DUPLEX || SPI_IO_SPLIT_CHAIN)
+// DMA buffers, rounded up to whole words for the DMA engine. With SPI_IO_ASYNC they hold the frame being clocked out,
+// so that the modules can go on writing motor_buffer and reading sensor_buffer while it's in flight. Each chain reads
+// its inputs into its own word-aligned part of sensor_frame, at SpiChainBuffers::frame_offset.
+#if SPI_IO_SPLIT_CHAIN
+BUFFER_ATTRS uint8_t sensor_frame[SPI_CHAIN_BUFFERS[1].frame_offset
+    + _SPI_DMA_LENGTH(_SPI_FRAME_LENGTH(NUM_MODULES - MODULE_CHAIN_SPLIT))];
 #else
-    modules[i] = new (moduleBuffer[i]) SplitflapModule(motor_buffer[MOTOR_BUFFER_LENGTH - 1 - i/2], i % 2 == 0 ? 0 : 4, sensor_buffer[i/4], 1 << (i % 4));
+BUFFER_ATTRS uint8_t sensor_frame[_SPI_DMA_LENGTH(_SPI_FRAME_LENGTH(NUM_MODULES))];
 #endif
-  }
-  
-  memset(motor_buffer, 0, MOTOR_BUFFER_LENGTH);
-  memset(sensor_buffer, 0, SENSOR_BUFFER_LENGTH);
+#if SPI_IO_ASYNC
+BUFFER_ATTRS uint8_t motor_frame[_SPI_DMA_LENGTH(MOTOR_BUFFER_LENGTH)];
+#endif
+#endif
+#undef _SPI_FRAME_LENGTH
+#undef _SPI_DMA_LENGTH
 
-  // Initialize SPI
-#ifdef IN_LATCH_PIN
-  pinMode(IN_LATCH_PIN, OUTPUT);
-  digitalWrite(IN_LATCH_PIN, HIGH);
+#if defined(ESP32) && SPI_IO_FULL_DUPLEX
+#if SPI_IO_FULL_DUPLEX_SKEW
+// First sensor bit of each chain, read straight off MISO before the frame since the SPI peripheral misses it
+volatile uint8_t first_sensor_bit[SPI_IO_CHAINS];
 #endif
 
-#ifdef OUT_LATCH_PIN
-  pinMode(OUT_LATCH_PIN, OUTPUT);
-  digitalWrite(OUT_LATCH_PIN, LOW);
+// Start of a full-duplex frame: load the sensor inputs into the 74HC165s and leave them shifting. The rising edge also
+// latches the 74HC595s again, with the outputs they already have.
+void load_inputs(spi_transaction_t *trans) {
+    const SpiChain& chain = SPI_CHAINS[(uintptr_t)trans->user];
+    digitalWrite(chain.latch_pin, LOW);
+    digitalWrite(chain.latch_pin, HIGH);
+#if SPI_IO_FULL_DUPLEX_SKEW
+    first_sensor_bit[(uintptr_t)trans->user] = digitalRead(chain.miso_pin);
 #endif
+}
 
-#ifdef LATCH_PIN
-  pinMode(LATCH_PIN, OUTPUT);
-  digitalWrite(LATCH_PIN, LOW);
+// End of a full-duplex frame: latch the motor data just shifted into the 74HC595s onto their outputs
+void latch_outputs(spi_transaction_t *trans) {
+    const SpiChain& chain = SPI_CHAINS[(uintptr_t)trans->user];
+    digitalWrite(chain.latch_pin, LOW);
+    digitalWrite(chain.latch_pin, HIGH);
+}
+#elif defined(ESP32)
+void reset_latch(spi_transaction_t *trans) {
+    digitalWrite(SPI_CHAINS[(uintptr_t)trans->user].latch_pin, LOW);
+}
+
+void latch_registers(spi_transaction_t *trans) {
+    digitalWrite(SPI_CHAINS[(uintptr_t)trans->user].latch_pin, HIGH);
+}
 #endif
 
 #ifdef ESP32
-
+// Adds chain c's devices to its bus, clocked at clock_hz
+inline void add_spi_devices(uint8_t c, uint32_t clock_hz) {
   esp_err_t ret;
+  const SpiChain& chain = SPI_CHAINS[c];
 
-  //Initialize the SPI bus
-  spi_bus_config_t tx_bus_config = {
-      .mosi_io_num = PIN_NUM_MOSI,
-      .miso_io_num = PIN_NUM_MISO,
-      .sclk_io_num = PIN_NUM_CLK,
-      .quadwp_io_num = -1,
-      .quadhd_io_num = -1,
-      .max_transfer_sz = 1000,
+#if SPI_IO_FULL_DUPLEX
+  // Motor data out and sensor data in on the same clock, in the 74HC595s' mode
+  spi_device_interface_config_t device_config = {
+      .command_bits=0,
+      .address_bits=0,
+      .dummy_bits=0,
+      .mode=3,
+      .duty_cycle_pos=0,
+      .cs_ena_pretrans=0,
+      .cs_ena_posttrans=0,
+      .clock_speed_hz=(int)clock_hz,
+      .input_delay_ns=30,
+      .spics_io_num=-1,
+      .flags = 0,
+      .queue_size=1,
+      .pre_cb=&load_inputs,
+      .post_cb=&latch_outputs,
   };
-  ret=spi_bus_initialize(SPI_HOST, &tx_bus_config, DMA_CHANNEL);
+  ret=spi_bus_add_device(chain.host, &device_config, &spi_tx[c]);
   ESP_ERROR_CHECK(ret);
-
+#else
   spi_device_interface_config_t tx_device_config = {
       .command_bits=0,
       .address_bits=0,
@@ -184,7 +280,7 @@ inline void initialize_modules() {
       .duty_cycle_pos=0,
       .cs_ena_pretrans=0,
       .cs_ena_posttrans=0,
-      .clock_speed_hz=SPI_CLOCK,
+      .clock_speed_hz=(int)clock_hz,
       .input_delay_ns=0,
       .spics_io_num=-1,
       .flags = 0,
@@ -192,7 +288,7 @@ inline void initialize_modules() {
       .pre_cb=NULL,
       .post_cb=NULL,
   };
-  ret=spi_bus_add_device(SPI_HOST, &tx_device_config, &spi_tx);
+  ret=spi_bus_add_device(chain.host, &tx_device_config, &spi_tx[c]);
   ESP_ERROR_CHECK(ret);
 
   spi_device_interface_config_t rx_device_config = {
@@ -203,7 +299,7 @@ inline void initialize_modules() {
       .duty_cycle_pos=0,
       .cs_ena_pretrans=0,
       .cs_ena_posttrans=0,
-      .clock_speed_hz=SPI_CLOCK,
+      .clock_speed_hz=(int)clock_hz,
       .input_delay_ns=30,
       .spics_io_num=-1,
       .flags = SPI_DEVICE_HALFDUPLEX,
@@ -211,19 +307,74 @@ inline void initialize_modules() {
       .pre_cb=&latch_registers,
       .post_cb=&reset_latch,
   };
-  ret=spi_bus_add_device(SPI_HOST, &rx_device_config, &spi_rx);
+  ret=spi_bus_add_device(chain.host, &rx_device_config, &spi_rx[c]);
   ESP_ERROR_CHECK(ret);
+#endif
+}
+#endif
+inline void initialize_modules() {
+  initialize_module_chain();
 
-  memset(&tx_transaction, 0, sizeof(tx_transaction));
-  tx_transaction.length = MOTOR_BUFFER_LENGTH*8;
-  tx_transaction.tx_buffer = &motor_buffer;
-  tx_transaction.rx_buffer = NULL;
+  // Initialize SPI
+#ifdef IN_LATCH_PIN
+  pinMode(IN_LATCH_PIN, OUTPUT);
+  digitalWrite(IN_LATCH_PIN, HIGH);
+#endif
 
-  memset(&rx_transaction, 0, sizeof(rx_transaction));
-  rx_transaction.length = SENSOR_BUFFER_LENGTH*8;
-  rx_transaction.rxlength = SENSOR_BUFFER_LENGTH*8;
-  rx_transaction.tx_buffer = NULL;
-  rx_transaction.rx_buffer = &sensor_buffer;
+#ifdef OUT_LATCH_PIN
+  pinMode(OUT_LATCH_PIN, OUTPUT);
+  digitalWrite(OUT_LATCH_PIN, LOW);
+#endif
+
+#ifdef ESP32
+  esp_err_t ret;
+
+  for (uint8_t c = 0; c < SPI_IO_CHAINS; c++) {
+    const SpiChain& chain = SPI_CHAINS[c];
+    const SpiChainBuffers& buffers = SPI_CHAIN_BUFFERS[c];
+
+    pinMode(chain.latch_pin, OUTPUT);
+    digitalWrite(chain.latch_pin, LOW);
+
+    //Initialize the SPI bus
+    spi_bus_config_t tx_bus_config = {
+        .mosi_io_num = chain.mosi_pin,
+        .miso_io_num = chain.miso_pin,
+        .sclk_io_num = chain.clk_pin,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = 1000,
+    };
+    ret=spi_bus_initialize(chain.host, &tx_bus_config, chain.dma_channel);
+    ESP_ERROR_CHECK(ret);
+
+    add_spi_devices(c, SPI_CLOCK);
+
+    memset(&tx_transaction[c], 0, sizeof(tx_transaction[c]));
+    tx_transaction[c].length = buffers.motor_length*8;
+    tx_transaction[c].user = (void*)(uintptr_t)c;
+#if SPI_IO_ASYNC
+    tx_transaction[c].tx_buffer = &motor_frame[buffers.motor_offset];
+#else
+    tx_transaction[c].tx_buffer = &motor_buffer[buffers.motor_offset];
+#endif
+#if SPI_IO_FULL_DUPLEX
+    tx_transaction[c].rx_buffer = &sensor_frame[buffers.frame_offset];
+#else
+    tx_transaction[c].rx_buffer = NULL;
+
+    memset(&rx_transaction[c], 0, sizeof(rx_transaction[c]));
+    rx_transaction[c].length = buffers.sensor_length*8;
+    rx_transaction[c].rxlength = buffers.sensor_length*8;
+    rx_transaction[c].user = (void*)(uintptr_t)c;
+    rx_transaction[c].tx_buffer = NULL;
+#if SPI_IO_ASYNC || SPI_IO_SPLIT_CHAIN
+    rx_transaction[c].rx_buffer = &sensor_frame[buffers.frame_offset];
+#else
+    rx_transaction[c].rx_buffer = &sensor_buffer;
+#endif
+#endif
+  }
 
 #else
   SPI.begin();
@@ -231,17 +382,105 @@ inline void initialize_modules() {
 #endif
 }
 
+#if defined(ESP32) && (SPI_IO_ASYNC || SPI_IO_FULL_DUPLEX || SPI_IO_SPLIT_CHAIN)
+// Copies the sensor inputs clocked in by the last frame from sensor_frame to each chain's part of sensor_buffer
+inline void read_sensor_frame() {
+  for (uint8_t c = 0; c < SPI_IO_CHAINS; c++) {
+    const SpiChainBuffers& buffers = SPI_CHAIN_BUFFERS[c];
+    const uint8_t* frame = &sensor_frame[buffers.frame_offset];
+    uint8_t* sensors = &sensor_buffer[buffers.sensor_offset];
+#if SPI_IO_FULL_DUPLEX && SPI_IO_FULL_DUPLEX_SKEW
+    // The first bit is lost, as on the ESP8266 below, so everything arrives one place late; it was read in
+    // load_inputs()
+    uint8_t extra_bit = first_sensor_bit[c];
+    for (uint8_t i = 0; i < buffers.sensor_length; i++) {
+      sensors[i] = (extra_bit << 7) | (frame[i] >> 1);
+      extra_bit = frame[i] & B00000001;
+    }
+#else
+    memcpy(sensors, frame, buffers.sensor_length);
+#endif
+  }
+}
+#endif
+
+#if defined(ESP32) && (SPI_IO_ASYNC || SPI_IO_SPLIT_CHAIN)
+// Queues a frame on every chain. The chains' hosts clock their frames out at the same time. Transactions are taken
+// from a host's devices in the order they were added to the bus, so each chain's read (whose pre/post callbacks
+// toggle its latch) always follows the write of the same frame. With SPI_IO_FULL_DUPLEX the single transaction does
+// both.
+inline void queue_frame() {
+    esp_err_t ret;
+    for (uint8_t c = 0; c < SPI_IO_CHAINS; c++) {
+      ret=spi_device_queue_trans(spi_tx[c], &tx_transaction[c], portMAX_DELAY);
+      assert(ret==ESP_OK);
+#if !SPI_IO_FULL_DUPLEX
+      ret=spi_device_queue_trans(spi_rx[c], &rx_transaction[c], portMAX_DELAY);
+      assert(ret==ESP_OK);
+#endif
+    }
+    frame_in_flight = true;
+}
+#endif
+
+// With SPI_IO_ASYNC, waits for the frame queued by the last motor_sensor_io() to be clocked out and copies the sensor
+// inputs it read into sensor_buffer. Otherwise motor_sensor_io() has already done both, and this does nothing.
+inline void motor_sensor_io_wait() {
+#if defined(ESP32) && (SPI_IO_ASYNC || SPI_IO_SPLIT_CHAIN)
+    if (!frame_in_flight) {
+      return;
+    }
+    esp_err_t ret;
+    spi_transaction_t* result;
+
+    for (uint8_t c = 0; c < SPI_IO_CHAINS; c++) {
+      ret=spi_device_get_trans_result(spi_tx[c], &result, portMAX_DELAY);
+      assert(ret==ESP_OK);
+#if !SPI_IO_FULL_DUPLEX
+      ret=spi_device_get_trans_result(spi_rx[c], &result, portMAX_DELAY);
+      assert(ret==ESP_OK);
+#endif
+    }
+
+    read_sensor_frame();
+    sensor_frame_received();
+    frame_in_flight = false;
+#endif
+}
+
 inline void motor_sensor_io() {
 #ifdef ESP32
+#if SPI_IO_ASYNC
+    // Collect the previous frame (normally done by now, since the caller has had a whole pass of work to do since
+    // queueing it), then queue motor_buffer as the next one and return while it's clocked out. sensor_buffer is
+    // therefore always one frame behind.
+    motor_sensor_io_wait();
+    memcpy(motor_frame, motor_buffer, MOTOR_BUFFER_LENGTH);
+    queue_frame();
+#elif SPI_IO_SPLIT_CHAIN
+    // Run both chains' frames at once, and wait for them
+    queue_frame();
+    motor_sensor_io_wait();
+#elif SPI_IO_FULL_DUPLEX
+    esp_err_t ret;
+
+    // Send and receive data
+    ret=spi_device_polling_transmit(spi_tx[0], &tx_transaction[0]);
+    assert(ret==ESP_OK);
+    read_sensor_frame();
+    sensor_frame_received();
+#else
     esp_err_t ret;
-    
+
     // Send data
-    ret=spi_device_polling_transmit(spi_tx, &tx_transaction);
+    ret=spi_device_polling_transmit(spi_tx[0], &tx_transaction[0]);
     assert(ret==ESP_OK);
 
     // Receive data
-    ret=spi_device_polling_transmit(spi_rx, &rx_transaction);
+    ret=spi_device_polling_transmit(spi_rx[0], &rx_transaction[0]);
     assert(ret==ESP_OK);
+    sensor_frame_received();
+#endif
 #else
   IN_LATCH();
   delayMicroseconds(1);
@@ -267,93 +506,22 @@ inline void motor_sensor_io() {
   }
 
   OUT_LATCH();
+  sensor_frame_received();
 #endif
 }
 
-#ifdef CHAINLINK
-void chainlink_set_led(uint8_t moduleIndex, bool on) {
-  uint8_t groupPosition = moduleIndex % 6;
-  uint8_t byteIndex = MOTOR_BUFFER_LENGTH - 1 - moduleIndex/6*4 - (groupPosition < 3 ? 1 : 2);
-  uint8_t bitMask = (groupPosition < 3) ? (1 << (4 + groupPosition)) : (1 << (groupPosition - 3));
-  if (on) {
-    motor_buffer[byteIndex] |= bitMask;
-  } else {
-    motor_buffer[byteIndex] &= ~bitMask;
+#ifdef ESP32
+// Re-adds every chain's devices at clock_hz, once any frame in flight is done
+inline void motor_sensor_io_set_clock(uint32_t clock_hz) {
+  motor_sensor_io_wait();
+  for (uint8_t c = 0; c < SPI_IO_CHAINS; c++) {
+    ESP_ERROR_CHECK(spi_bus_remove_device(spi_tx[c]));
+#if !SPI_IO_FULL_DUPLEX
+    ESP_ERROR_CHECK(spi_bus_remove_device(spi_rx[c]));
+#endif
+    add_spi_devices(c, clock_hz);
   }
 }
-
-static uint8_t chainlink_loopbackMotorByte(uint8_t loopbackIndex) {
-  return MOTOR_BUFFER_LENGTH - 1 - (loopbackIndex / 2) * 4 - (((loopbackIndex % 2) == 0) ? 1 : 2);
-}
-static uint8_t chainlink_loopbackMotorBitMask(uint8_t loopbackIndex) {
-  return (loopbackIndex % 2) == 0 ? (1 << 7) : (1 << 3);
-}
-static uint8_t chainlink_loopbackSensorByte(uint8_t loopbackIndex) {
-  return loopbackIndex / 2;
-}
-static uint8_t chainlink_loopbackSensorBitMask(uint8_t loopbackIndex) {
-  return (loopbackIndex % 2) == 0 ? 1 << 6 : 1 << 7;
-}
-
-bool chainlink_test_startup_loopback(bool results[NUM_LOOPBACKS]) {
-    bool success = true;
-
-    // Turn off all motors, leds, and loopbacks; make sure all loopback inputs read 0
-    memset(motor_buffer, 0, MOTOR_BUFFER_LENGTH);
-    motor_sensor_io();
-    motor_sensor_io();
-
-    for (uint8_t i = 0; i < NUM_LOOPBACKS; i++) {
-      results[i] = ((sensor_buffer[chainlink_loopbackSensorByte(i)] & chainlink_loopbackSensorBitMask(i))) == 0;
-      success &= results[i];
-    }
-    return success;
-}
-
-void chainlink_set_loopback(uint8_t loop_out_index) {
-    // Turn on loopback output
-    motor_buffer[chainlink_loopbackMotorByte(loop_out_index)] |= chainlink_loopbackMotorBitMask(loop_out_index);
-}
-
-/**
- * Validate that the loopback from loop_out_index can be read successfully. There must be AT LEAST 2 motor_sensor_io() invocations
- * between setting the loopback and validating it - one for turning on the shift register output and another to read in the shift
- * register input.
- */
-bool chainlink_validate_loopback(uint8_t loop_out_index, bool results[NUM_LOOPBACKS]) {
-    bool success = true;
-    for (uint8_t loop_in_index = 0; loop_in_index < NUM_LOOPBACKS; loop_in_index++) {
-      uint8_t expected_bit_mask = (loop_out_index == loop_in_index) ? chainlink_loopbackSensorBitMask(loop_in_index) : 0;
-      uint8_t actual_bit_mask = sensor_buffer[chainlink_loopbackSensorByte(loop_in_index)] & chainlink_loopbackSensorBitMask(loop_in_index);
-
-      bool ok = actual_bit_mask == expected_bit_mask;
-      success &= ok;
-      if (results != nullptr) {
-        results[loop_in_index] = ok;
-      }
-    }
-
-    // Turn off loopback output
-    motor_buffer[chainlink_loopbackMotorByte(loop_out_index)] &= ~chainlink_loopbackMotorBitMask(loop_out_index);
-    return success;
-}
-
-bool chainlink_test_all_loopbacks(bool loopback_result[NUM_LOOPBACKS][NUM_LOOPBACKS], bool loopback_off_result[NUM_LOOPBACKS]) {
-    bool loopback_success = true;
-
-    // Turn one loopback bit on at a time and make sure only that loopback bit is set
-    for (uint8_t loop_out_index = 0; loop_out_index < NUM_LOOPBACKS; loop_out_index++) {
-      chainlink_set_loopback(loop_out_index);
-      motor_sensor_io();
-      motor_sensor_io();
-      loopback_success &= chainlink_validate_loopback(loop_out_index, loopback_result[loop_out_index]);
-    }
-
-    loopback_success &= chainlink_test_startup_loopback(loopback_off_result);
-
-    return loopback_success;
-}
-
 #endif
 
 #endif
@@ -0,0 +1,764 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SPLITFLAP_BATCH_H
+#define SPLITFLAP_BATCH_H
+
+#include <Arduino.h>
+
+#include "splitflap_module.h"
+
+// Structure-of-arrays stepping engine for a whole chain of modules.
+//
+// Behaves exactly like an array of SplitflapModule instances sharing a single motor/sensor buffer, but keeps each
+// piece of per-module state in its own contiguous array and advances every module in one pass with a single
+// timestamp. Phase nibbles are written directly into the shared motor buffer using per-module byte indexes, rather
+// than through a reference held by each module.
+//
+// SplitflapBatchModule (below) provides the per-module SplitflapModule interface on top of the batch, so code that
+// talks to modules[i] does not need to know which engine is in use.
+
+#if GEAR_RATIO_INPUT_STEPS * 2 > 0xFFFF
+#error "SplitflapBatch stores step positions as uint16_t; GEAR_RATIO_INPUT_STEPS is too large"
+#endif
+
+template <uint8_t MAX_MODULES>
+class SplitflapBatch {
+ public:
+#if SENSOR_EDGE_LATCH
+  SplitflapBatch(uint8_t* motor_buffer, uint8_t* sensor_buffer, uint8_t* sensor_edges) :
+      motor_buffer_(motor_buffer),
+      sensor_buffer_(sensor_buffer),
+      sensor_edges_(sensor_edges) {
+  }
+#else
+  SplitflapBatch(uint8_t* motor_buffer, uint8_t* sensor_buffer) :
+      motor_buffer_(motor_buffer),
+      sensor_buffer_(sensor_buffer) {
+  }
+#endif
+
+  // Configuration:
+  uint8_t num_modules = 0;
+
+  // Public state (mirrors SplitflapModule's public members):
+  State state[MAX_MODULES];
+  uint8_t current_accel_step[MAX_MODULES];
+  uint8_t count_unexpected_home[MAX_MODULES];
+  uint8_t count_missed_home[MAX_MODULES];
+
+  void AttachModule(uint8_t index, uint8_t motor_byte, uint8_t motor_bitshift, uint8_t sensor_byte, uint8_t sensor_bitmask);
+
+  inline void Update(unsigned long now);
+  inline void UpdateModule(uint8_t i, unsigned long now);
+
+  void GoToFlapIndex(uint8_t i, uint8_t index);
+  uint8_t GetCurrentFlapIndex(uint8_t i);
+  uint8_t GetTargetFlapIndex(uint8_t i);
+  void GoHome(uint8_t i);
+  void ResetErrorCounters(uint8_t i);
+  void ResetState(uint8_t i);
+  void Init(uint8_t i);
+  bool GetHomeState(uint8_t i);
+  void Disable(uint8_t i);
+  inline bool IsIdle(uint8_t i);
+  inline bool IsAccelerating(uint8_t i);
+  void SetMotionProfile(uint8_t i, uint8_t profile);
+  uint8_t GetMotionProfile(uint8_t i);
+  bool GetRestingPosition(uint8_t i, ModulePosition& position);
+  bool ResumeAt(uint8_t i, const ModulePosition& position);
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+  HomeCalibration GetHomeCalibration(uint8_t i);
+  void SetHomeCalibration(uint8_t i, const HomeCalibration& calibration);
+#endif
+#if STEP_TIMING_STATS
+  StepTimingStats GetStepTimingStats(uint8_t i);
+  void ResetStepTimingStats(uint8_t i);
+#endif
+#if SPEED_CALIBRATION
+  void SetMinStepPeriod(uint8_t i, uint16_t min_period_micros);
+#endif
+
+ private:
+  uint8_t* const motor_buffer_;
+  uint8_t* const sensor_buffer_;
+#if SENSOR_EDGE_LATCH
+  uint8_t* const sensor_edges_;  // see sensor_edge_latch.h
+#endif
+
+  // IO mapping
+  uint8_t motor_byte_[MAX_MODULES];
+  uint8_t motor_bitshift_[MAX_MODULES];
+  uint8_t sensor_byte_[MAX_MODULES];
+  uint8_t sensor_bitmask_[MAX_MODULES];
+
+  // Timing (micros(), or frame count with FRAME_CLOCK)
+  unsigned long last_update_time_[MAX_MODULES];
+  uint16_t current_period_[MAX_MODULES];
+  uint8_t motion_profile_[MAX_MODULES];
+  uint8_t requested_motion_profile_[MAX_MODULES];
+  bool accelerating_[MAX_MODULES];
+#if SPEED_CALIBRATION
+  uint8_t max_accel_step_[MAX_MODULES][Acceleration::NUM_MOTION_PROFILES];
+#endif
+#if STEP_TIMING_STATS
+  StepTimingStats step_timing_[MAX_MODULES];
+#endif
+
+  // Position/destination. Numbers are modulo GEAR_RATIO_INPUT_STEPS
+  uint16_t current_step_[MAX_MODULES];
+  uint16_t delta_steps_[MAX_MODULES];
+  uint8_t current_phase_[MAX_MODULES];
+  uint8_t target_flap_index_[MAX_MODULES];
+
+  // Flap position, tracked incrementally as in SplitflapModule (current_flap is current_step_'s flap floor,
+  // current_flap_index_ the flap showing, and next_flap_step_ where current_flap_ next increments)
+  uint8_t current_flap_[MAX_MODULES];
+  uint8_t current_flap_index_[MAX_MODULES];
+  uint16_t next_flap_step_[MAX_MODULES];
+
+  bool last_home_[MAX_MODULES];
+#if HOME_CALIBRATION_ENABLED
+  HomeState home_state_[MAX_MODULES];
+  uint16_t unexpected_home_start_step_[MAX_MODULES];
+  uint16_t unexpected_home_end_step_[MAX_MODULES];
+  uint16_t missed_home_step_[MAX_MODULES];
+#if ADAPTIVE_HOME_WINDOWS || FAST_HOMING
+  uint16_t expected_home_step_[MAX_MODULES];
+#endif
+#if ADAPTIVE_HOME_WINDOWS
+  HomeCalibration home_calibration_[MAX_MODULES];
+#endif
+#if FAST_HOMING
+  HomingPhase homing_phase_[MAX_MODULES];
+#endif
+#endif
+
+  inline void Step(uint8_t i, unsigned long now);
+  inline bool CheckSensor(uint8_t i);
+  inline void SetMotor(uint8_t i, uint8_t out);
+  inline void ResetPosition(uint8_t i);
+  inline void AdvanceFlap(uint8_t i);
+  inline void GoToTargetFlapIndex(uint8_t i);
+  inline void UpdateExpectedHome(uint8_t i, uint32_t unexpected_home_start_buffer_steps);
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+  inline void LearnHomePosition(uint8_t i);
+#endif
+#if HOME_CALIBRATION_ENABLED && FAST_HOMING
+  inline void RefineHomePosition(uint8_t i);
+  inline uint8_t GetApproachAccelStep(uint8_t i, const Acceleration::MotionProfile& profile, uint8_t target_accel_step);
+#endif
+};
+
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::AttachModule(uint8_t i, uint8_t motor_byte, uint8_t motor_bitshift, uint8_t sensor_byte, uint8_t sensor_bitmask) {
+  motor_byte_[i] = motor_byte;
+  motor_bitshift_[i] = motor_bitshift;
+  sensor_byte_[i] = sensor_byte;
+  sensor_bitmask_[i] = sensor_bitmask;
+
+#if HOME_CALIBRATION_ENABLED
+  state[i] = SENSOR_ERROR; // Start in SENSOR_ERROR state until initialized
+  home_state_[i] = IGNORE;
+  unexpected_home_start_step_[i] = 0;
+  unexpected_home_end_step_[i] = 0;
+  missed_home_step_[i] = 0;
+#if ADAPTIVE_HOME_WINDOWS || FAST_HOMING
+  expected_home_step_[i] = 0;
+#endif
+#if ADAPTIVE_HOME_WINDOWS
+  home_calibration_[i] = HomeCalibration();
+#endif
+#if FAST_HOMING
+  homing_phase_[i] = HOMING_PRECISE;
+#endif
+#else
+  state[i] = NORMAL;
+#endif
+  current_accel_step[i] = 0;
+  count_unexpected_home[i] = 0;
+  count_missed_home[i] = 0;
+  last_update_time_[i] = 0;
+  motion_profile_[i] = Acceleration::MOTION_PROFILE_NORMAL;
+  requested_motion_profile_[i] = Acceleration::MOTION_PROFILE_NORMAL;
+  accelerating_[i] = false;
+  current_period_[i] = ACCEL_STEP_PERIOD(Acceleration::MOTION_PROFILES[Acceleration::MOTION_PROFILE_NORMAL], 0);
+#if SPEED_CALIBRATION
+  SetMinStepPeriod(i, ACCEL_FAST_MIN_PERIOD_MICROS);
+#endif
+#if STEP_TIMING_STATS
+  step_timing_[i] = StepTimingStats();
+#endif
+  ResetPosition(i);
+  delta_steps_[i] = 0;
+  current_phase_[i] = 0;
+  target_flap_index_[i] = 0;
+  last_home_[i] = false;
+
+  if (i >= num_modules) {
+    num_modules = i + 1;
+  }
+}
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline bool SplitflapBatch<MAX_MODULES>::CheckSensor(uint8_t i) {
+#if SENSOR_EDGE_LATCH
+  uint8_t& edges = sensor_edges_[sensor_byte_[i]];
+  bool shift = (edges & sensor_bitmask_[i]) != 0;
+  edges &= ~sensor_bitmask_[i];
+  return shift;
+#else
+  bool cur_home = (sensor_buffer_[sensor_byte_[i]] & sensor_bitmask_[i]) != 0;
+  bool shift = cur_home && !last_home_[i];
+  last_home_[i] = cur_home;
+  return shift;
+#endif
+}
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline void SplitflapBatch<MAX_MODULES>::SetMotor(uint8_t i, uint8_t out) {
+  uint8_t& motor_out = motor_buffer_[motor_byte_[i]];
+  uint8_t shift = motor_bitshift_[i];
+  motor_out = (motor_out & ~(0x0F << shift)) | ((out & 0x0F) << shift);
+}
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline void SplitflapBatch<MAX_MODULES>::ResetPosition(uint8_t i) {
+  current_step_[i] = 0;
+  current_flap_[i] = 0;
+  current_flap_index_[i] = 0;
+  next_flap_step_[i] = Flaps::StepForFlap(1);
+}
+
+// Called when current_step_ reaches next_flap_step_
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline void SplitflapBatch<MAX_MODULES>::AdvanceFlap(uint8_t i) {
+  uint8_t flap = current_flap_[i] + 1;
+  uint8_t flap_index = current_flap_index_[i] + 1;
+  if (flap_index == NUM_FLAPS) {
+    flap_index = 0;
+  }
+  if (flap == GEAR_RATIO_OUTPUT_FLAPS) {
+    // The last flap ends exactly at GEAR_RATIO_INPUT_STEPS, which is step 0 of the next cycle
+    flap = 0;
+    current_step_[i] = 0;
+  }
+  current_flap_[i] = flap;
+  current_flap_index_[i] = flap_index;
+  next_flap_step_[i] = Flaps::StepForFlap(flap + 1);
+}
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline void SplitflapBatch<MAX_MODULES>::GoToTargetFlapIndex(uint8_t i) {
+  if (state[i] != NORMAL) {
+    return;
+  }
+  delta_steps_[i] = Flaps::TargetStep(current_flap_[i], current_flap_index_[i], target_flap_index_[i]) - current_step_[i];
+}
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline void SplitflapBatch<MAX_MODULES>::UpdateExpectedHome(uint8_t i, uint32_t unexpected_home_start_buffer_steps) {
+#if HOME_CALIBRATION_ENABLED
+  uint32_t expected_home = Flaps::NextHomeStep(missed_home_step_[i]);
+
+#if ADAPTIVE_HOME_WINDOWS || FAST_HOMING
+  expected_home_step_[i] = expected_home >= GEAR_RATIO_INPUT_STEPS ? expected_home - GEAR_RATIO_INPUT_STEPS : expected_home;
+#endif
+#if ADAPTIVE_HOME_WINDOWS
+  uint32_t window_center = expected_home + home_calibration_[i].OffsetSteps(HOME_ERROR_MARGIN_STEPS);
+  uint16_t margin = home_calibration_[i].MarginSteps(HOME_ERROR_MARGIN_STEPS);
+#else
+  uint32_t window_center = expected_home;
+  uint16_t margin = HOME_ERROR_MARGIN_STEPS;
+#endif
+
+  uint32_t new_unexpected_home_start_step = current_step_[i] + unexpected_home_start_buffer_steps;
+  uint32_t new_unexpected_home_end_step = window_center - margin;
+  uint32_t new_missed_home_step = window_center + margin;
+
+  if (new_unexpected_home_start_step >= GEAR_RATIO_INPUT_STEPS) {
+    new_unexpected_home_start_step -= GEAR_RATIO_INPUT_STEPS;
+  }
+  if (new_unexpected_home_end_step >= GEAR_RATIO_INPUT_STEPS) {
+    new_unexpected_home_end_step -= GEAR_RATIO_INPUT_STEPS;
+  }
+  if (new_missed_home_step >= GEAR_RATIO_INPUT_STEPS) {
+    new_missed_home_step -= GEAR_RATIO_INPUT_STEPS;
+  }
+
+  unexpected_home_start_step_[i] = new_unexpected_home_start_step;
+  unexpected_home_end_step_[i] = new_unexpected_home_end_step;
+  missed_home_step_[i] = new_missed_home_step;
+  home_state_[i] = IGNORE;
+#endif
+}
+
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+template <uint8_t MAX_MODULES>
+inline void SplitflapBatch<MAX_MODULES>::LearnHomePosition(uint8_t i) {
+  int32_t error = (int32_t)current_step_[i] - (int32_t)expected_home_step_[i];
+  if (error > (int32_t)GEAR_RATIO_INPUT_STEPS / 2) {
+    error -= GEAR_RATIO_INPUT_STEPS;
+  } else if (error < -(int32_t)GEAR_RATIO_INPUT_STEPS / 2) {
+    error += GEAR_RATIO_INPUT_STEPS;
+  }
+  home_calibration_[i].Learn(error);
+}
+#endif
+
+#if HOME_CALIBRATION_ENABLED && FAST_HOMING
+template <uint8_t MAX_MODULES>
+inline void SplitflapBatch<MAX_MODULES>::RefineHomePosition(uint8_t i) {
+  int32_t error = (int32_t)current_step_[i] - (int32_t)expected_home_step_[i];
+  if (error > (int32_t)GEAR_RATIO_INPUT_STEPS / 2) {
+    error -= GEAR_RATIO_INPUT_STEPS;
+  } else if (error < -(int32_t)GEAR_RATIO_INPUT_STEPS / 2) {
+    error += GEAR_RATIO_INPUT_STEPS;
+  }
+
+  ResetPosition(i);
+  while (next_flap_step_[i] <= expected_home_step_[i]) {
+    AdvanceFlap(i);
+  }
+  current_step_[i] = expected_home_step_[i];
+  int32_t new_delta_steps = (int32_t)delta_steps_[i] + error;
+  delta_steps_[i] = new_delta_steps > 0 ? new_delta_steps : 0;
+  homing_phase_[i] = HOMING_PRECISE;
+}
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline uint8_t SplitflapBatch<MAX_MODULES>::GetApproachAccelStep(uint8_t i, const Acceleration::MotionProfile& profile, uint8_t target_accel_step) {
+  uint32_t max_accel_step = profile.homing_accel_step;
+  if (home_state_[i] != EXPECTED) {
+    uint16_t end = unexpected_home_end_step_[i];
+    uint16_t current_step = current_step_[i];
+    max_accel_step += end >= current_step ? end - current_step : end + GEAR_RATIO_INPUT_STEPS - current_step;
+  }
+  return target_accel_step < max_accel_step ? target_accel_step : max_accel_step;
+}
+#endif
+
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::GoToFlapIndex(uint8_t i, uint8_t index) {
+  if (state[i] != NORMAL
+#if HOME_CALIBRATION_ENABLED
+   && state[i] != LOOK_FOR_HOME
+#endif
+  ) {
+    return;
+  }
+  target_flap_index_[i] = index;
+  GoToTargetFlapIndex(i);
+}
+
+template <uint8_t MAX_MODULES>
+uint8_t SplitflapBatch<MAX_MODULES>::GetCurrentFlapIndex(uint8_t i) {
+  return current_flap_index_[i];
+}
+
+template <uint8_t MAX_MODULES>
+uint8_t SplitflapBatch<MAX_MODULES>::GetTargetFlapIndex(uint8_t i) {
+  return target_flap_index_[i];
+}
+
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::GoHome(uint8_t i) {
+#if HOME_CALIBRATION_ENABLED
+  if (state[i] == PANIC || state[i] == STATE_DISABLED) {
+    return;
+  }
+  state[i] = LOOK_FOR_HOME;
+  delta_steps_[i] = MAX_STEPS_LOOKING_FOR_HOME;
+#if FAST_HOMING
+  homing_phase_[i] = HOMING_COARSE;
+#endif
+#endif
+}
+
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::ResetErrorCounters(uint8_t i) {
+  count_unexpected_home[i] = 0;
+  count_missed_home[i] = 0;
+}
+
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::ResetState(uint8_t i) {
+  ResetErrorCounters(i);
+  CheckSensor(i);
+
+  target_flap_index_[i] = 0;
+  ResetPosition(i);
+  delta_steps_[i] = 0;
+
+#if HOME_CALIBRATION_ENABLED
+  home_state_[i] = IGNORE;
+  unexpected_home_start_step_[i] = 0;
+  unexpected_home_end_step_[i] = 0;
+  missed_home_step_[i] = 0;
+#endif
+}
+
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::Init(uint8_t i) {
+  CheckSensor(i);
+}
+
+template <uint8_t MAX_MODULES>
+bool SplitflapBatch<MAX_MODULES>::GetHomeState(uint8_t i) {
+  return (sensor_buffer_[sensor_byte_[i]] & sensor_bitmask_[i]) != 0;
+}
+
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::Disable(uint8_t i) {
+  SetMotor(i, 0);
+  state[i] = STATE_DISABLED;
+}
+
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::SetMotionProfile(uint8_t i, uint8_t profile) {
+  if (profile >= Acceleration::NUM_MOTION_PROFILES) {
+    return;
+  }
+  requested_motion_profile_[i] = profile;
+  if (current_accel_step[i] == 0) {
+    motion_profile_[i] = profile;
+  }
+}
+
+template <uint8_t MAX_MODULES>
+uint8_t SplitflapBatch<MAX_MODULES>::GetMotionProfile(uint8_t i) {
+  return requested_motion_profile_[i];
+}
+
+template <uint8_t MAX_MODULES>
+bool SplitflapBatch<MAX_MODULES>::GetRestingPosition(uint8_t i, ModulePosition& position) {
+  if (state[i] != NORMAL || current_accel_step[i] != 0 || delta_steps_[i] != 0) {
+    return false;
+  }
+  position.step = current_step_[i];
+  position.phase = current_phase_[i];
+  position.target_flap_index = target_flap_index_[i];
+  return true;
+}
+
+template <uint8_t MAX_MODULES>
+bool SplitflapBatch<MAX_MODULES>::ResumeAt(uint8_t i, const ModulePosition& position) {
+  if (state[i] == PANIC || state[i] == STATE_DISABLED || position.step >= GEAR_RATIO_INPUT_STEPS
+      || position.phase >= STEP_PATTERN_LENGTH || position.target_flap_index >= NUM_FLAPS) {
+    return false;
+  }
+  // Must be exactly on the target flap's first step
+  ResetPosition(i);
+  while (next_flap_step_[i] <= position.step) {
+    AdvanceFlap(i);
+  }
+  if (Flaps::StepForFlap(current_flap_[i]) != position.step || current_flap_index_[i] != position.target_flap_index) {
+    ResetPosition(i);
+    return false;
+  }
+
+  state[i] = NORMAL;
+  current_step_[i] = position.step;
+  current_phase_[i] = position.phase;
+  target_flap_index_[i] = position.target_flap_index;
+  delta_steps_[i] = 0;
+  current_accel_step[i] = 0;
+#if HOME_CALIBRATION_ENABLED
+  missed_home_step_[i] = position.step;
+  UpdateExpectedHome(i, 0);
+#if FAST_HOMING
+  homing_phase_[i] = HOMING_APPROACH;
+#endif
+#endif
+  return true;
+}
+
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+template <uint8_t MAX_MODULES>
+HomeCalibration SplitflapBatch<MAX_MODULES>::GetHomeCalibration(uint8_t i) {
+  return home_calibration_[i];
+}
+
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::SetHomeCalibration(uint8_t i, const HomeCalibration& calibration) {
+  home_calibration_[i] = calibration;
+}
+#endif
+
+#if STEP_TIMING_STATS
+template <uint8_t MAX_MODULES>
+StepTimingStats SplitflapBatch<MAX_MODULES>::GetStepTimingStats(uint8_t i) {
+  return step_timing_[i];
+}
+
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::ResetStepTimingStats(uint8_t i) {
+  step_timing_[i] = StepTimingStats();
+}
+#endif
+
+#if SPEED_CALIBRATION
+template <uint8_t MAX_MODULES>
+void SplitflapBatch<MAX_MODULES>::SetMinStepPeriod(uint8_t i, uint16_t min_period_micros) {
+  for (uint8_t profile = 0; profile < Acceleration::NUM_MOTION_PROFILES; profile++) {
+    max_accel_step_[i][profile] = Acceleration::MaxAccelStepForMinPeriod(Acceleration::MOTION_PROFILES[profile], min_period_micros);
+  }
+}
+#endif
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline bool SplitflapBatch<MAX_MODULES>::IsIdle(uint8_t i) {
+  if (state[i] == PANIC || state[i] == STATE_DISABLED) {
+    return true;
+  }
+  if (current_accel_step[i] != 0) {
+    return false;
+  }
+  return state[i] == NORMAL ? delta_steps_[i] == 0 : state[i] != LOOK_FOR_HOME;
+}
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline bool SplitflapBatch<MAX_MODULES>::IsAccelerating(uint8_t i) {
+  return accelerating_[i] && current_accel_step[i] != 0;
+}
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline void SplitflapBatch<MAX_MODULES>::Update(unsigned long now) {
+  for (uint8_t i = 0; i < num_modules; i++) {
+    // Cheapest check first: most modules are not due for a step on any given pass
+    if (now - last_update_time_[i] >= current_period_[i] && state[i] != PANIC && state[i] != STATE_DISABLED) {
+      Step(i, now);
+    }
+  }
+}
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline void SplitflapBatch<MAX_MODULES>::UpdateModule(uint8_t i, unsigned long now) {
+  if (state[i] == PANIC || state[i] == STATE_DISABLED) {
+    return;
+  }
+  if (now - last_update_time_[i] >= current_period_[i]) {
+    Step(i, now);
+  }
+}
+
+template <uint8_t MAX_MODULES>
+__attribute__((always_inline))
+inline void SplitflapBatch<MAX_MODULES>::Step(uint8_t i, unsigned long now) {
+#if STEP_TIMING_STATS
+  if (current_accel_step[i] > 0) {
+    step_timing_[i].Record(now - last_update_time_[i] - current_period_[i]);
+  }
+#endif
+  last_update_time_[i] = now;
+
+  const Acceleration::MotionProfile& profile = Acceleration::MOTION_PROFILES[motion_profile_[i]];
+  uint8_t target_accel_step;
+
+  if (state[i] == NORMAL) {
+    bool reset_to_home = false;
+#if HOME_CALIBRATION_ENABLED
+    uint16_t current_step = current_step_[i];
+    bool found_home = CheckSensor(i);
+    HomeState home_state = home_state_[i];
+    if (home_state == IGNORE) {
+      if (current_step == unexpected_home_start_step_[i]) {
+        home_state_[i] = UNEXPECTED;
+      }
+    } else if (home_state == UNEXPECTED) {
+      if (found_home) {
+        count_unexpected_home[i]++;
+        reset_to_home = true;
+      } else if (current_step == unexpected_home_end_step_[i]) {
+        home_state_[i] = EXPECTED;
+      }
+    } else if (home_state == EXPECTED) {
+      if (FAKE_HOME_SENSOR || found_home) {
+#if FAST_HOMING
+        if (found_home && homing_phase_[i] == HOMING_APPROACH) {
+          RefineHomePosition(i);
+          found_home = false;
+        }
+#endif
+#if ADAPTIVE_HOME_WINDOWS
+        if (found_home) {
+          LearnHomePosition(i);
+        }
+#endif
+        UpdateExpectedHome(i, UNEXPECTED_HOME_START_BUFFER_STEPS);
+      } else if (current_step == missed_home_step_[i]) {
+        count_missed_home[i]++;
+        reset_to_home = true;
+      }
+    }
+#endif
+
+    if (reset_to_home) {
+      GoHome(i);
+      target_accel_step = 0;
+    } else if (delta_steps_[i] > profile.max_accel_step) {
+      target_accel_step = profile.max_accel_step;
+    } else {
+      target_accel_step = delta_steps_[i];
+    }
+#if HOME_CALIBRATION_ENABLED && FAST_HOMING
+    if (homing_phase_[i] == HOMING_APPROACH) {
+      target_accel_step = GetApproachAccelStep(i, profile, target_accel_step);
+    }
+#endif
+#if HOME_CALIBRATION_ENABLED
+  } else if (state[i] == LOOK_FOR_HOME) {
+    bool found_home = CheckSensor(i);
+    if (FAKE_HOME_SENSOR || found_home) {
+      state[i] = NORMAL;
+      target_accel_step = 0;
+
+      // Reset frame of reference
+      ResetPosition(i);
+      unexpected_home_start_step_[i] = 0;
+      unexpected_home_end_step_[i] = 0;
+      missed_home_step_[i] = 0;
+      UpdateExpectedHome(i, UNEXPECTED_HOME_START_BUFFER_STEPS);
+#if FAST_HOMING
+      if (homing_phase_[i] == HOMING_COARSE) {
+        homing_phase_[i] = HOMING_APPROACH;
+      }
+#endif
+
+      GoToTargetFlapIndex(i);
+    } else if (delta_steps_[i] == 0) {
+      state[i] = SENSOR_ERROR;
+      target_accel_step = 0;
+    } else {
+#if FAST_HOMING
+      target_accel_step = homing_phase_[i] == HOMING_COARSE ? profile.max_accel_step : profile.homing_accel_step;
+#else
+      target_accel_step = profile.homing_accel_step;
+#endif
+    }
+#endif
+  } else {
+    target_accel_step = 0;
+  }
+#if SPEED_CALIBRATION
+  if (target_accel_step > max_accel_step_[i][motion_profile_[i]]) {
+    target_accel_step = max_accel_step_[i][motion_profile_[i]];
+  }
+#endif
+
+  // Update motor
+  uint8_t accel_step = current_accel_step[i];
+  if (accel_step < target_accel_step) {
+    accel_step++;
+  } else if (accel_step > target_accel_step) {
+    accel_step--;
+  }
+  current_accel_step[i] = accel_step;
+  accelerating_[i] = accel_step < target_accel_step;
+  if (accel_step == 0) {
+    motion_profile_[i] = requested_motion_profile_[i];
+  }
+  current_period_[i] = ACCEL_STEP_PERIOD(Acceleration::MOTION_PROFILES[motion_profile_[i]], accel_step);
+
+  if (accel_step > 0) {
+    current_step_[i]++;
+    if (current_step_[i] == next_flap_step_[i]) {
+      AdvanceFlap(i);
+    }
+
+    uint8_t phase = current_phase_[i] + 1;
+    if (phase == STEP_PATTERN_LENGTH) {
+      phase = 0;
+    }
+    current_phase_[i] = phase;
+
+    if (delta_steps_[i] > 0) {
+      delta_steps_[i]--;
+    }
+    SetMotor(i, step_pattern[phase]);
+  } else {
+    SetMotor(i, 0);
+  }
+}
+
+
+// Per-module view of a SplitflapBatch, exposing the same interface as SplitflapModule. Public state is exposed through
+// references into the batch's arrays, so `modules[i]->state` etc. work unchanged.
+template <uint8_t MAX_MODULES>
+class SplitflapBatchModuleT {
+ private:
+  SplitflapBatch<MAX_MODULES>& batch;
+  const uint8_t index;
+
+ public:
+  SplitflapBatchModuleT(SplitflapBatch<MAX_MODULES>& batch, uint8_t index) :
+      batch(batch),
+      index(index),
+      state(batch.state[index]),
+      current_accel_step(batch.current_accel_step[index]),
+      count_unexpected_home(batch.count_unexpected_home[index]),
+      count_missed_home(batch.count_missed_home[index]) {
+  }
+
+  State& state;
+  uint8_t& current_accel_step;
+  uint8_t& count_unexpected_home;
+  uint8_t& count_missed_home;
+
+  void GoToFlapIndex(uint8_t flap_index) { batch.GoToFlapIndex(index, flap_index); }
+  uint8_t GetCurrentFlapIndex() { return batch.GetCurrentFlapIndex(index); }
+  uint8_t GetTargetFlapIndex() { return batch.GetTargetFlapIndex(index); }
+  void GoHome() { batch.GoHome(index); }
+  void ResetErrorCounters() { batch.ResetErrorCounters(index); }
+  void ResetState() { batch.ResetState(index); }
+#if !FRAME_CLOCK
+  void Update() { batch.UpdateModule(index, micros()); }
+#endif
+  void Update(unsigned long now) { batch.UpdateModule(index, now); }
+  void Init() { batch.Init(index); }
+  bool GetHomeState() { return batch.GetHomeState(index); }
+  void Disable() { batch.Disable(index); }
+  bool IsIdle() { return batch.IsIdle(index); }
+  bool IsAccelerating() { return batch.IsAccelerating(index); }
+  void SetMotionProfile(uint8_t profile) { batch.SetMotionProfile(index, profile); }
+  uint8_t GetMotionProfile() { return batch.GetMotionProfile(index); }
+  bool GetRestingPosition(ModulePosition& position) { return batch.GetRestingPosition(index, position); }
+  bool ResumeAt(const ModulePosition& position) { return batch.ResumeAt(index, position); }
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+  HomeCalibration GetHomeCalibration() { return batch.GetHomeCalibration(index); }
+  void SetHomeCalibration(const HomeCalibration& calibration) { batch.SetHomeCalibration(index, calibration); }
+#endif
+#if STEP_TIMING_STATS
+  StepTimingStats GetStepTimingStats() { return batch.GetStepTimingStats(index); }
+  void ResetStepTimingStats() { batch.ResetStepTimingStats(index); }
+#endif
+#if SPEED_CALIBRATION
+  void SetMinStepPeriod(uint16_t min_period_micros) { batch.SetMinStepPeriod(index, min_period_micros); }
+#endif
+};
+
+#endif
@@ -20,7 +20,10 @@
 #include <Arduino.h>
 
 #include "acceleration.h"
+#include "flap_boundaries.h"
+#include "home_calibration.h"
 #include "splitflap_module_data.h"
+#include "step_timing_stats.h"
 #include "../config.h"
 
 // Logging and assertions are useful for debugging, but likely add too much time/space overhead to be used when
@@ -30,7 +33,17 @@
 
 #define FAKE_HOME_SENSOR false
 
+// Time base for Update(now). Normally `now` is micros() and step periods are in microseconds. With FRAME_CLOCK, `now`
+// is a frame counter advanced by a fixed-rate timer and step periods are whole frames (see Acceleration::MotionProfile).
+#define ACCEL_STEP_PERIOD(profile, accel_step) pgm_read_word_near((profile).periods + (accel_step))
+
+#if HALF_STEP_DRIVE
+#define STEPS_PER_MOTOR_REVOLUTION (64)
+#define STEP_PATTERN_LENGTH (8)
+#else
 #define STEPS_PER_MOTOR_REVOLUTION (32)
+#define STEP_PATTERN_LENGTH (4)
+#endif
 
 // The gear ratio constants below represent the input:output ratio of the gearbox expressed as a simplified fraction.
 // For example, for a gear train with ratios 31:10, 26:9, 22:11, 32:9, the overall ratio expressed as integers would be
@@ -51,6 +64,10 @@
 // accumulate.
 #define _ROUGH_STEPS_PER_FLAP (GEAR_RATIO_INPUT_STEPS / GEAR_RATIO_OUTPUT_FLAPS)
 
+// Step at which each flap is reached, counting from home through the GEAR_RATIO_INPUT_STEPS cycle (plus one more
+// revolution for targets beyond the end of the cycle)
+typedef FlapBoundaries<GEAR_RATIO_INPUT_STEPS, GEAR_RATIO_OUTPUT_FLAPS, NUM_FLAPS> Flaps;
+
 #if HOME_CALIBRATION_ENABLED
 // The number of steps in either direction that's acceptable error for the home sensor
 #define HOME_ERROR_MARGIN_STEPS (_ROUGH_STEPS_PER_FLAP / 4)
@@ -70,10 +87,13 @@ class SplitflapModule {
 
   uint8_t &sensor_in;
   const uint8_t sensor_bitmask;
+#if SENSOR_EDGE_LATCH
+  uint8_t &sensor_edges;  // sensor_in's byte of sensor_edges (see sensor_edge_latch.h)
+#endif
 
   // State:
   bool last_home = false;
-  unsigned long last_update_micros = 0;
+  unsigned long last_update_time = 0;  // micros(), or frame count with FRAME_CLOCK
 
   // Tracks the most recent target flap index. Not used during motion, but needed to recalculate target step if we
   // re-calibrate the home position
@@ -83,6 +103,13 @@ class SplitflapModule {
   uint32_t current_step = 0;
   uint32_t delta_steps = 0;
 
+  // Flap position, tracked incrementally as current_step advances so that no division is needed while moving:
+  // current_flap is current_step's flap floor (0 <= current_flap < GEAR_RATIO_OUTPUT_FLAPS), current_flap_index is
+  // the flap showing (current_flap % NUM_FLAPS), and next_flap_step is where current_flap next increments.
+  uint8_t current_flap = 0;
+  uint8_t current_flap_index = 0;
+  uint32_t next_flap_step = Flaps::StepForFlap(1);
+
 #if HOME_CALIBRATION_ENABLED
   // Home calibration state. All values recalculated whenever we see a home sensor blip
   HomeState home_state = IGNORE;
@@ -92,20 +119,54 @@ class SplitflapModule {
   // Expected home position step plus some margin of error. If we get to this step without having seen a home
   // sensor blip, something is wrong and we need to recalibrate.
   uint32_t missed_home_step = 0;
+
+#if ADAPTIVE_HOME_WINDOWS || FAST_HOMING
+  // Nominal step of the home blip the current window is waiting for
+  uint32_t expected_home_step = 0;
+#endif
+#if ADAPTIVE_HOME_WINDOWS
+  // What's been learned about where the home blip really lands relative to expected_home_step
+  HomeCalibration home_calibration = {};
+#endif
+#if FAST_HOMING
+  HomingPhase homing_phase = HOMING_PRECISE;
+#endif
 #endif
 
   // Motor state
   uint8_t current_phase = 0;
-  uint16_t current_period = Acceleration::ACCEL_STEP_PERIODS[0];
+  uint16_t current_period = ACCEL_STEP_PERIOD(Acceleration::MOTION_PROFILES[Acceleration::MOTION_PROFILE_NORMAL], 0);
+#if STEP_TIMING_STATS
+  StepTimingStats step_timing = {};
+#endif
+
+  // Index into Acceleration::MOTION_PROFILES. A newly requested profile only takes effect once the motor is stopped,
+  // since accel steps from one profile's ramp don't correspond to the same speed in another's.
+  uint8_t motion_profile = Acceleration::MOTION_PROFILE_NORMAL;
+  uint8_t requested_motion_profile = Acceleration::MOTION_PROFILE_NORMAL;
+
+  // Whether current_accel_step was still short of its target after the last step (see IsAccelerating)
+  bool accelerating = false;
+#if SPEED_CALIBRATION
+  // Top accel step allowed in each profile by this module's minimum step period (see SetMinStepPeriod)
+  uint8_t max_accel_step[Acceleration::NUM_MOTION_PROFILES];
+#endif
 
   void Panic(String message);
   bool CheckSensor();
   void SetMotor(uint8_t out);
 
-  uint8_t GetFlapFloor(uint32_t step);
-  uint32_t GetTargetStepForFlapIndex(uint32_t from_step, uint8_t target_flap_index);
+  void ResetPosition();
+  void AdvanceFlap();
   void GoToTargetFlapIndex();
-  void UpdateExpectedHome();
+  void UpdateExpectedHome(uint32_t unexpected_home_start_buffer_steps);
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+  void LearnHomePosition();
+#endif
+#if HOME_CALIBRATION_ENABLED && FAST_HOMING
+  void RefineHomePosition();
+  uint8_t GetApproachAccelStep(const Acceleration::MotionProfile& profile, uint8_t target_accel_step);
+#endif
 
  public:
   SplitflapModule(
@@ -113,6 +174,9 @@ class SplitflapModule {
     const uint8_t motor_bitshift,
     uint8_t &sensor_in,
     const uint8_t sensor_bitmask
+#if SENSOR_EDGE_LATCH
+    , uint8_t &sensor_edges
+#endif
   );
 
 #if HOME_CALIBRATION_ENABLED
@@ -128,10 +192,30 @@ class SplitflapModule {
   void GoHome();
   void ResetErrorCounters();
   void ResetState();
+#if !FRAME_CLOCK
   inline void Update();
+#endif
+  inline void Update(unsigned long now);
   void Init();
   bool GetHomeState();
   void Disable();
+  inline bool IsIdle();
+  inline bool IsAccelerating();
+  void SetMotionProfile(uint8_t profile);
+  uint8_t GetMotionProfile();
+  bool GetRestingPosition(ModulePosition& position);
+  bool ResumeAt(const ModulePosition& position);
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+  HomeCalibration GetHomeCalibration();
+  void SetHomeCalibration(const HomeCalibration& calibration);
+#endif
+#if STEP_TIMING_STATS
+  StepTimingStats GetStepTimingStats();
+  void ResetStepTimingStats();
+#endif
+#if SPEED_CALIBRATION
+  void SetMinStepPeriod(uint16_t min_period_micros);
+#endif
   
   uint8_t count_unexpected_home = 0;
   uint8_t count_missed_home = 0;
@@ -144,8 +228,28 @@ class SplitflapModule {
 #define MOT_PHASE_C B00000010
 #define MOT_PHASE_D B00000001
 
-const uint8_t step_pattern[] = {
+const uint8_t step_pattern[STEP_PATTERN_LENGTH] = {
+#if HALF_STEP_DRIVE
 #if REVERSE_MOTOR_DIRECTION
+  MOT_PHASE_D | MOT_PHASE_A,
+  MOT_PHASE_D,
+  MOT_PHASE_C | MOT_PHASE_D,
+  MOT_PHASE_C,
+  MOT_PHASE_B | MOT_PHASE_C,
+  MOT_PHASE_B,
+  MOT_PHASE_A | MOT_PHASE_B,
+  MOT_PHASE_A,
+#else
+  MOT_PHASE_A | MOT_PHASE_B,
+  MOT_PHASE_B,
+  MOT_PHASE_B | MOT_PHASE_C,
+  MOT_PHASE_C,
+  MOT_PHASE_C | MOT_PHASE_D,
+  MOT_PHASE_D,
+  MOT_PHASE_D | MOT_PHASE_A,
+  MOT_PHASE_A,
+#endif
+#elif REVERSE_MOTOR_DIRECTION
   MOT_PHASE_D | MOT_PHASE_A,
   MOT_PHASE_C | MOT_PHASE_D,
   MOT_PHASE_B | MOT_PHASE_C,
@@ -162,12 +266,22 @@ SplitflapModule::SplitflapModule(
   uint8_t &motor_out,
   const uint8_t motor_bitshift,
   uint8_t &sensor_in,
-  const uint8_t sensor_bitmask) :
+  const uint8_t sensor_bitmask
+#if SENSOR_EDGE_LATCH
+  , uint8_t &sensor_edges
+#endif
+  ) :
     motor_out(motor_out),
     motor_bitshift(motor_bitshift),
     sensor_in(sensor_in),
     sensor_bitmask(sensor_bitmask)
+#if SENSOR_EDGE_LATCH
+    , sensor_edges(sensor_edges)
+#endif
 {
+#if SPEED_CALIBRATION
+    SetMinStepPeriod(ACCEL_FAST_MIN_PERIOD_MICROS);
+#endif
 }
 
 void SplitflapModule::Disable() {
@@ -184,11 +298,18 @@ void SplitflapModule::Panic(String message) {
 
 __attribute__((always_inline))
 inline bool SplitflapModule::CheckSensor() {
+#if SENSOR_EDGE_LATCH
+    // Consume any rising edge latched since the last check, even if the sensor has already dropped again
+    bool shift = (sensor_edges & sensor_bitmask) != 0;
+    sensor_edges &= ~sensor_bitmask;
+    return shift;
+#else
     bool cur_home = (sensor_in & sensor_bitmask) != 0;
     bool shift = cur_home == true && last_home == false;
     last_home = cur_home;
 
     return shift;
+#endif
 }
 
 __attribute__((always_inline))
@@ -197,67 +318,27 @@ inline void SplitflapModule::SetMotor(uint8_t out) {
 }
 
 __attribute__((always_inline))
-inline uint8_t SplitflapModule::GetFlapFloor(uint32_t step) {
-    return step * GEAR_RATIO_OUTPUT_FLAPS / GEAR_RATIO_INPUT_STEPS;
+inline void SplitflapModule::ResetPosition() {
+    current_step = 0;
+    current_flap = 0;
+    current_flap_index = 0;
+    next_flap_step = Flaps::StepForFlap(1);
 }
 
+// Called when current_step reaches next_flap_step
 __attribute__((always_inline))
-inline uint32_t SplitflapModule::GetTargetStepForFlapIndex(uint32_t from_step, uint8_t target_flap_index) {
-
-#if ASSERTIONS_ENABLED
-    //assert 0 <= from_step < 2*GEAR_RATIO_INPUT_STEPS
-    if (from_step < 0 || from_step >= 2 * GEAR_RATIO_INPUT_STEPS) {
-        Panic("from_step < 0 || from_step >= 2 * GEAR_RATIO_INPUT_STEPS");
-    }
-#endif
-
-    uint8_t from_flap = GetFlapFloor(from_step);
-
-#if ASSERTIONS_ENABLED
-    //assert 0 <= from_flap < 2*NUM_FLAPS
-    if (from_flap < 0 || from_flap >= 2 * NUM_FLAPS) {
-        Panic("from_flap < 0 || from_flap >= 2 * NUM_FLAPS");
+inline void SplitflapModule::AdvanceFlap() {
+    current_flap++;
+    current_flap_index++;
+    if (current_flap_index == NUM_FLAPS) {
+        current_flap_index = 0;
     }
-#endif
-
-    uint8_t from_flap_index;
-    if (from_flap >= NUM_FLAPS) {
-        from_flap_index = from_flap - NUM_FLAPS;
-    } else {
-        from_flap_index = from_flap;
-    }
-
-    int8_t delta_flaps;
-    if (target_flap_index > from_flap_index) {
-        delta_flaps = target_flap_index - from_flap_index;
-    } else {
-        // Even if we're exactly at the target flap index, still do a full revolution to get to the target flap
-        // since we're working with rounded numbers
-        delta_flaps = NUM_FLAPS + target_flap_index - from_flap_index;
-    }
-
-#if VERBOSE_LOGGING
-    Serial.print("VERBOSE: DELTA FLAPS=");
-    Serial.print(delta_flaps);
-    Serial.print('\n');
-#endif
-
-#if ASSERTIONS_ENABLED
-    //assert 0 < delta_flaps <= 40
-    if (delta_flaps <= 0 || delta_flaps > NUM_FLAPS) {
-        Panic("delta_flaps <= 0 || delta_flaps > NUM_FLAPS");
+    if (current_flap == GEAR_RATIO_OUTPUT_FLAPS) {
+        // The last flap ends exactly at GEAR_RATIO_INPUT_STEPS, which is step 0 of the next cycle
+        current_flap = 0;
+        current_step = 0;
     }
-#endif
-
-    uint32_t gear_ratio_input_steps_flaps_destination = ((uint32_t)from_flap + (uint32_t)delta_flaps) * GEAR_RATIO_INPUT_STEPS;
-
-    // Round UP when dividing so that the inverse calculation on the result (_get_flap_floor) returns the expected
-    // result.
-    uint32_t result = gear_ratio_input_steps_flaps_destination / GEAR_RATIO_OUTPUT_FLAPS;
-    if (gear_ratio_input_steps_flaps_destination % GEAR_RATIO_OUTPUT_FLAPS != 0) {
-        result++;
-    }
-    return result;
+    next_flap_step = Flaps::StepForFlap(current_flap + 1);
 }
 
 __attribute__((always_inline))
@@ -265,7 +346,7 @@ inline void SplitflapModule::GoToTargetFlapIndex() {
     if (state != NORMAL) {
         return;
     }
-    delta_steps = GetTargetStepForFlapIndex(current_step, target_flap_index) - current_step;
+    delta_steps = Flaps::TargetStep(current_flap, current_flap_index, target_flap_index) - current_step;
 
 
 #if VERBOSE_LOGGING
@@ -286,17 +367,28 @@ inline void SplitflapModule::GoToTargetFlapIndex() {
 }
 
 __attribute__((always_inline))
-inline void SplitflapModule::UpdateExpectedHome() {
+inline void SplitflapModule::UpdateExpectedHome(uint32_t unexpected_home_start_buffer_steps) {
 #if HOME_CALIBRATION_ENABLED
     // Expected home position is the next 0 index flap position after the missed_home_step. This must be calculated
     // from the missed_home_step, rather than current_step, so that in the event of an early home, we don't compute
     // the next home as the one that is just a few steps away.
 
-    uint32_t expected_home = GetTargetStepForFlapIndex(missed_home_step, 0);
+    uint32_t expected_home = Flaps::NextHomeStep(missed_home_step);
 
-    uint32_t new_unexpected_home_start_step = current_step + UNEXPECTED_HOME_START_BUFFER_STEPS;
-    uint32_t new_unexpected_home_end_step = expected_home - HOME_ERROR_MARGIN_STEPS;
-    uint32_t new_missed_home_step = expected_home + HOME_ERROR_MARGIN_STEPS;
+#if ADAPTIVE_HOME_WINDOWS || FAST_HOMING
+    expected_home_step = expected_home >= GEAR_RATIO_INPUT_STEPS ? expected_home - GEAR_RATIO_INPUT_STEPS : expected_home;
+#endif
+#if ADAPTIVE_HOME_WINDOWS
+    uint32_t window_center = expected_home + home_calibration.OffsetSteps(HOME_ERROR_MARGIN_STEPS);
+    uint16_t margin = home_calibration.MarginSteps(HOME_ERROR_MARGIN_STEPS);
+#else
+    uint32_t window_center = expected_home;
+    uint16_t margin = HOME_ERROR_MARGIN_STEPS;
+#endif
+
+    uint32_t new_unexpected_home_start_step = current_step + unexpected_home_start_buffer_steps;
+    uint32_t new_unexpected_home_end_step = window_center - margin;
+    uint32_t new_missed_home_step = window_center + margin;
 
 #if VERBOSE_LOGGING
     Serial.print("Calculated new expected home ");
@@ -359,6 +451,72 @@ inline void SplitflapModule::UpdateExpectedHome() {
 #endif
 }
 
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+// Called when a home blip is found within the EXPECTED window, before UpdateExpectedHome moves on to the next one
+inline void SplitflapModule::LearnHomePosition() {
+    int32_t error = (int32_t)current_step - (int32_t)expected_home_step;
+    if (error > (int32_t)GEAR_RATIO_INPUT_STEPS / 2) {
+        error -= GEAR_RATIO_INPUT_STEPS;
+    } else if (error < -(int32_t)GEAR_RATIO_INPUT_STEPS / 2) {
+        error += GEAR_RATIO_INPUT_STEPS;
+    }
+    home_calibration.Learn(error);
+
+#if VERBOSE_LOGGING
+    Serial.print("VERBOSE: Home offset ");
+    Serial.print(error);
+    Serial.print(", learned ");
+    Serial.print(home_calibration.offset);
+    Serial.print('/');
+    Serial.print(home_calibration.spread);
+    Serial.print('\n');
+#endif
+}
+#endif
+
+#if HOME_CALIBRATION_ENABLED && FAST_HOMING
+// Called in place of LearnHomePosition when the home edge is found in the expected window after a fast homing search.
+// The edge becomes the precise reference: the current position is relabelled as the expected home step, and any
+// remaining move is lengthened or shortened by the difference so it still ends on the same flap.
+inline void SplitflapModule::RefineHomePosition() {
+    int32_t error = (int32_t)current_step - (int32_t)expected_home_step;
+    if (error > (int32_t)GEAR_RATIO_INPUT_STEPS / 2) {
+        error -= GEAR_RATIO_INPUT_STEPS;
+    } else if (error < -(int32_t)GEAR_RATIO_INPUT_STEPS / 2) {
+        error += GEAR_RATIO_INPUT_STEPS;
+    }
+
+    ResetPosition();
+    while (next_flap_step <= expected_home_step) {
+        AdvanceFlap();
+    }
+    current_step = expected_home_step;
+
+    int32_t new_delta_steps = (int32_t)delta_steps + error;
+    delta_steps = new_delta_steps > 0 ? new_delta_steps : 0;
+    homing_phase = HOMING_PRECISE;
+
+#if VERBOSE_LOGGING
+    Serial.print("VERBOSE: Refined home by ");
+    Serial.print(error);
+    Serial.print('\n');
+#endif
+}
+
+// While approaching the first expected home window after a fast homing search, limits speed to homing speed within
+// the window, slowing down ahead of it so as to enter it at homing speed
+__attribute__((always_inline))
+inline uint8_t SplitflapModule::GetApproachAccelStep(const Acceleration::MotionProfile& profile, uint8_t target_accel_step) {
+    uint32_t max_accel_step = profile.homing_accel_step;
+    if (home_state != EXPECTED) {
+        uint32_t steps_to_window = unexpected_home_end_step >= current_step
+            ? unexpected_home_end_step - current_step
+            : unexpected_home_end_step + GEAR_RATIO_INPUT_STEPS - current_step;
+        max_accel_step += steps_to_window;
+    }
+    return target_accel_step < max_accel_step ? target_accel_step : max_accel_step;
+}
+#endif
 
 __attribute__((always_inline))
 inline void SplitflapModule::GoToFlapIndex(uint8_t index) {
@@ -375,7 +533,7 @@ inline void SplitflapModule::GoToFlapIndex(uint8_t index) {
 
 __attribute__((always_inline))
 inline uint8_t SplitflapModule::GetCurrentFlapIndex() {
-   return (uint8_t)(GetFlapFloor(current_step) % NUM_FLAPS);
+   return current_flap_index;
 }
 
 uint8_t SplitflapModule::GetTargetFlapIndex() {
@@ -391,20 +549,35 @@ inline void SplitflapModule::GoHome() {
 
     state = LOOK_FOR_HOME;
     delta_steps = MAX_STEPS_LOOKING_FOR_HOME;
+#if FAST_HOMING
+    homing_phase = HOMING_COARSE;
+#endif
 #endif
 }
 
+#if !FRAME_CLOCK
 __attribute__((always_inline))
 inline void SplitflapModule::Update() {
+    Update(micros());
+}
+#endif
+
+__attribute__((always_inline))
+inline void SplitflapModule::Update(unsigned long now) {
     if (state == PANIC || state == STATE_DISABLED) {
         return;
     }
 
-    unsigned long now = micros();
-    unsigned long delta_time = now - last_update_micros;
+    unsigned long delta_time = now - last_update_time;
     if (delta_time >= current_period) {
-        last_update_micros = now;
+        last_update_time = now;
+#if STEP_TIMING_STATS
+        if (current_accel_step > 0) {
+            step_timing.Record(delta_time - current_period);
+        }
+#endif
 
+        const Acceleration::MotionProfile& profile = Acceleration::MOTION_PROFILES[motion_profile];
         uint8_t target_accel_step;
 
         if (state == NORMAL) {
@@ -443,7 +616,19 @@ inline void SplitflapModule::Update() {
 #if VERBOSE_LOGGING
                     Serial.print("VERBOSE: Found expected home.");
 #endif
-                    UpdateExpectedHome();
+#if FAST_HOMING
+                    if (found_home && homing_phase == HOMING_APPROACH) {
+                        RefineHomePosition();
+                        // Not a blip to learn from, since the reference it was expected against was only rough
+                        found_home = false;
+                    }
+#endif
+#if ADAPTIVE_HOME_WINDOWS
+                    if (found_home) {
+                        LearnHomePosition();
+                    }
+#endif
+                    UpdateExpectedHome(UNEXPECTED_HOME_START_BUFFER_STEPS);
                 } else if (current_step == missed_home_step) {
                   count_missed_home++;
 #if VERBOSE_LOGGING
@@ -465,11 +650,16 @@ inline void SplitflapModule::Update() {
                 target_accel_step = 0;
             } else {
                 // Update speed based on distance to target
-                if (delta_steps > Acceleration::MAX_ACCEL_STEP) {
-                    target_accel_step = Acceleration::MAX_ACCEL_STEP;
+                if (delta_steps > profile.max_accel_step) {
+                    target_accel_step = profile.max_accel_step;
                 } else {
                     target_accel_step = delta_steps;
                 }
+#if HOME_CALIBRATION_ENABLED && FAST_HOMING
+                if (homing_phase == HOMING_APPROACH) {
+                    target_accel_step = GetApproachAccelStep(profile, target_accel_step);
+                }
+#endif
             }
 #if HOME_CALIBRATION_ENABLED
         } else if (state == LOOK_FOR_HOME) {
@@ -482,11 +672,16 @@ inline void SplitflapModule::Update() {
                 target_accel_step = 0;
 
                 // Reset frame of reference
-                current_step = 0;
+                ResetPosition();
                 unexpected_home_start_step = 0;
                 unexpected_home_end_step = 0;
                 missed_home_step = 0;
-                UpdateExpectedHome();
+                UpdateExpectedHome(UNEXPECTED_HOME_START_BUFFER_STEPS);
+#if FAST_HOMING
+                if (homing_phase == HOMING_COARSE) {
+                    homing_phase = HOMING_APPROACH;
+                }
+#endif
 
                 GoToTargetFlapIndex();
             } else {
@@ -497,13 +692,22 @@ inline void SplitflapModule::Update() {
                     state = SENSOR_ERROR;
                     target_accel_step = 0;
                 } else {
-                    target_accel_step = Acceleration::MAX_ACCEL_STEP / 8;
+#if FAST_HOMING
+                    target_accel_step = homing_phase == HOMING_COARSE ? profile.max_accel_step : profile.homing_accel_step;
+#else
+                    target_accel_step = profile.homing_accel_step;
+#endif
                 }
             }
 #endif
         } else {
             target_accel_step = 0;
         }
+#if SPEED_CALIBRATION
+        if (target_accel_step > max_accel_step[motion_profile]) {
+            target_accel_step = max_accel_step[motion_profile];
+        }
+#endif
 
         // Update motor
         if (current_accel_step < target_accel_step) {
@@ -511,16 +715,20 @@ inline void SplitflapModule::Update() {
         } else if (current_accel_step > target_accel_step) {
             current_accel_step--;
         }
+        accelerating = current_accel_step < target_accel_step;
 
-        current_period = pgm_read_word_near(Acceleration::ACCEL_STEP_PERIODS + current_accel_step);
+        if (current_accel_step == 0) {
+            motion_profile = requested_motion_profile;
+        }
+        current_period = ACCEL_STEP_PERIOD(Acceleration::MOTION_PROFILES[motion_profile], current_accel_step);
 
         if (current_accel_step > 0) {
             current_step++;
-            if (current_step == GEAR_RATIO_INPUT_STEPS) {
-                current_step = 0;
+            if (current_step == next_flap_step) {
+                AdvanceFlap();
             }
             current_phase++;
-            if (current_phase == 4) {
+            if (current_phase == STEP_PATTERN_LENGTH) {
                 current_phase = 0;
             }
             if (delta_steps > 0) {
@@ -551,7 +759,7 @@ void SplitflapModule::ResetState() {
     CheckSensor();
 
     target_flap_index = 0;
-    current_step = 0;
+    ResetPosition();
     delta_steps = 0;
 
 #if HOME_CALIBRATION_ENABLED
@@ -566,8 +774,120 @@ void SplitflapModule::Init() {
     CheckSensor();
 }
 
+void SplitflapModule::SetMotionProfile(uint8_t profile) {
+    if (profile >= Acceleration::NUM_MOTION_PROFILES) {
+        return;
+    }
+    requested_motion_profile = profile;
+    if (current_accel_step == 0) {
+        motion_profile = profile;
+    }
+}
+
+uint8_t SplitflapModule::GetMotionProfile() {
+    return requested_motion_profile;
+}
+
+// Fills in position and returns true if the module is stopped on its target flap
+bool SplitflapModule::GetRestingPosition(ModulePosition& position) {
+    if (state != NORMAL || current_accel_step != 0 || delta_steps != 0) {
+        return false;
+    }
+    position.step = current_step;
+    position.phase = current_phase;
+    position.target_flap_index = target_flap_index;
+    return true;
+}
+
+// Restores a position saved by GetRestingPosition (after Init, in place of GoHome). Since the spool may have been
+// moved in the meantime, home is checked again at the next expected home blip, with the unexpected-home region
+// starting right away rather than after the usual buffer. Returns false, leaving the module as it was, if the
+// position isn't one GetRestingPosition could have produced.
+bool SplitflapModule::ResumeAt(const ModulePosition& position) {
+    if (state == PANIC || state == STATE_DISABLED || position.step >= GEAR_RATIO_INPUT_STEPS
+            || position.phase >= STEP_PATTERN_LENGTH || position.target_flap_index >= NUM_FLAPS) {
+        return false;
+    }
+
+    ResetPosition();
+    while (next_flap_step <= position.step) {
+        AdvanceFlap();
+    }
+    if (Flaps::StepForFlap(current_flap) != position.step || current_flap_index != position.target_flap_index) {
+        ResetPosition();
+        return false;
+    }
+
+    state = NORMAL;
+    current_step = position.step;
+    current_phase = position.phase;
+    target_flap_index = position.target_flap_index;
+    delta_steps = 0;
+    current_accel_step = 0;
+#if HOME_CALIBRATION_ENABLED
+    missed_home_step = current_step;
+    UpdateExpectedHome(0);
+#if FAST_HOMING
+    homing_phase = HOMING_APPROACH;
+#endif
+#endif
+    return true;
+}
+
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+HomeCalibration SplitflapModule::GetHomeCalibration() {
+    return home_calibration;
+}
+
+// Takes effect from the next expected home window
+void SplitflapModule::SetHomeCalibration(const HomeCalibration& calibration) {
+    home_calibration = calibration;
+}
+#endif
+
+#if STEP_TIMING_STATS
+StepTimingStats SplitflapModule::GetStepTimingStats() {
+    return step_timing;
+}
+
+void SplitflapModule::ResetStepTimingStats() {
+    step_timing = StepTimingStats();
+}
+#endif
+
+#if SPEED_CALIBRATION
+// Caps the module's speed in every motion profile so that no step is shorter than min_period_micros. A module already
+// moving faster than that slows down one accel step per step, as it would for an approaching target.
+void SplitflapModule::SetMinStepPeriod(uint16_t min_period_micros) {
+    for (uint8_t profile = 0; profile < Acceleration::NUM_MOTION_PROFILES; profile++) {
+        max_accel_step[profile] = Acceleration::MaxAccelStepForMinPeriod(Acceleration::MOTION_PROFILES[profile], min_period_micros);
+    }
+}
+#endif
+
 bool SplitflapModule::GetHomeState() {
   return (sensor_in & sensor_bitmask) != 0;
 }
 
+// Whether Update() is guaranteed to be a no-op until the module is commanded again or its home sensor input changes:
+// the motor is stopped, there's no remaining motion, and any home state transition for the current step has already
+// been evaluated (that happens on the same update that brings current_accel_step to 0).
+__attribute__((always_inline))
+inline bool SplitflapModule::IsIdle() {
+  if (state == PANIC || state == STATE_DISABLED) {
+    return true;
+  }
+  if (current_accel_step != 0) {
+    return false;
+  }
+  return state == NORMAL ? delta_steps == 0 : state != LOOK_FOR_HOME;
+}
+
+// Whether the motor is still speeding up: false once it has reached the speed it's heading for (its cruise speed, or
+// less on a short move), while it slows down, and once it has stopped.
+__attribute__((always_inline))
+inline bool SplitflapModule::IsAccelerating() {
+  return accelerating && current_accel_step != 0;
+}
+
 #endif
@@ -26,6 +26,16 @@ enum HomeState {
     // Home position is expected in this state/region
     EXPECTED,
 };
+
+enum HomingPhase {
+    // Home position is known precisely; searches for home run at homing speed
+    HOMING_PRECISE,
+    // Searching for home at full speed (FAST_HOMING)
+    HOMING_COARSE,
+    // Home was found at full speed. The next expected home window is approached at homing speed, and the home edge
+    // found there becomes the precise reference.
+    HOMING_APPROACH,
+};
 #endif
 
 enum State {
@@ -35,3 +45,10 @@ enum State {
   PANIC,
   STATE_DISABLED,
 };
+
+// Position of a module at rest on a flap, enough to resume without homing after a warm reset (see WARM_BOOT_RESUME)
+struct ModulePosition {
+  uint32_t step;
+  uint8_t phase;
+  uint8_t target_flap_index;
+};
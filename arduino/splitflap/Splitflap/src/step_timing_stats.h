@@ -0,0 +1,51 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef STEP_TIMING_STATS_H
+#define STEP_TIMING_STATS_H
+
+#include <Arduino.h>
+
+// How late a module's steps fire (see STEP_TIMING_STATS in config.h).
+//
+// A step is due current_period after the previous one; its lateness is how much later than that the update that took
+// it ran, in the time base of Update(now) (microseconds, or frames with FRAME_CLOCK). Only steps taken while already
+// moving are counted, since a stopped module's next step waits for a command rather than for its period.
+//
+// Lateness is kept as a log2 histogram: bucket 0 counts steps that were on time and bucket b counts steps late by
+// [2^(b-1), 2^b), except the last bucket, which counts everything later. Counts saturate rather than wrap.
+
+#define STEP_TIMING_STATS_BUCKETS 12
+
+struct StepTimingStats {
+  uint16_t late_steps[STEP_TIMING_STATS_BUCKETS];
+  uint16_t max_late;  // Saturates at UINT16_MAX
+
+  void Record(unsigned long late) {
+    uint8_t bucket = 0;
+    for (unsigned long remaining = late; remaining != 0 && bucket < STEP_TIMING_STATS_BUCKETS - 1; remaining >>= 1) {
+      bucket++;
+    }
+    if (late_steps[bucket] != UINT16_MAX) {
+      late_steps[bucket]++;
+    }
+    if (late > max_late) {
+      max_late = late < UINT16_MAX ? late : UINT16_MAX;
+    }
+  }
+};
+
+#endif
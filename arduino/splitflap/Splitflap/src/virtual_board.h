@@ -0,0 +1,117 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef VIRTUAL_BOARD_H
+#define VIRTUAL_BOARD_H
+
+#include <Arduino.h>
+
+#include <stdlib.h>
+
+#include "io_layout.h"
+#include "splitflap_module.h"
+
+// Software stand-in for a chain of modules on shift register driver boards, laid out as in io_layout.h. Each call to
+// Update() plays the part of one motor_sensor_io() round trip: every spool whose phase pattern in motor_buffer has
+// changed advances one step, and its home sensor bit in sensor_buffer is set while the spool is over the home flag.
+// On chainlink boards each loopback input reads back its loopback output as latched by the previous Update(), as the
+// real chain does with a MOTOR_SENSOR_IO_ROUND_TRIP of 2.
+//
+// Used by the VIRTUAL_IO backend (virtual_io_config.h) and by the host benchmarks in bench/.
+
+// Motor steps per spool revolution (the home flag passes the sensor once per revolution)
+#define VIRTUAL_SPOOL_REVOLUTION_STEPS (GEAR_RATIO_INPUT_STEPS * NUM_FLAPS / GEAR_RATIO_OUTPUT_FLAPS)
+
+// Width of the simulated home sensor flag, in motor steps
+#define VIRTUAL_HOME_BLIP_STEPS (_ROUGH_STEPS_PER_FLAP / 2)
+
+struct VirtualSpool {
+    uint8_t motor_byte;
+    uint8_t motor_shift;
+    uint8_t sensor_byte;
+    uint8_t sensor_mask;
+    uint8_t last_pattern;
+    uint32_t position;
+};
+
+template <uint8_t MAX_MODULES>
+class VirtualBoard {
+    public:
+        uint8_t num_modules;
+        VirtualSpool spools[MAX_MODULES];
+
+        // Lays out num_modules spools (at positions drawn from rand() seeded with seed) with nothing latched yet
+        void Init(uint8_t count, bool chainlink, unsigned int seed) {
+            num_modules = count;
+            chainlink_ = chainlink;
+            memset(loopback_out_, 0, sizeof(loopback_out_));
+
+            srand(seed);
+            for (uint8_t i = 0; i < num_modules; i++) {
+                IoLayout::ModuleIo io = IoLayout::Module(num_modules, chainlink, i);
+                VirtualSpool& spool = spools[i];
+                spool.motor_byte = io.motor_byte;
+                spool.motor_shift = io.motor_bitshift;
+                spool.sensor_byte = io.sensor_byte;
+                spool.sensor_mask = io.sensor_bitmask;
+                spool.last_pattern = 0;
+                spool.position = rand() % VIRTUAL_SPOOL_REVOLUTION_STEPS;
+            }
+        }
+
+        void Update(const uint8_t* motor_buffer, uint8_t* sensor_buffer) {
+            for (uint8_t i = 0; i < num_modules; i++) {
+                VirtualSpool& spool = spools[i];
+                uint8_t pattern = (motor_buffer[spool.motor_byte] >> spool.motor_shift) & 0x0F;
+                if (pattern != 0 && pattern != spool.last_pattern) {
+                    spool.position++;
+                    if (spool.position == VIRTUAL_SPOOL_REVOLUTION_STEPS) {
+                        spool.position = 0;
+                    }
+                }
+                spool.last_pattern = pattern;
+
+                if (spool.position < VIRTUAL_HOME_BLIP_STEPS) {
+                    sensor_buffer[spool.sensor_byte] |= spool.sensor_mask;
+                } else {
+                    sensor_buffer[spool.sensor_byte] &= ~spool.sensor_mask;
+                }
+            }
+
+            if (chainlink_) {
+                for (uint8_t l = 0; l < num_modules / 3; l++) {
+                    IoLayout::LoopbackIo loopback = IoLayout::ChainlinkLoopback(num_modules, l);
+                    uint8_t out_mask = 1 << (l % 8);
+                    if (loopback_out_[l / 8] & out_mask) {
+                        sensor_buffer[loopback.in.byte] |= loopback.in.bitmask;
+                    } else {
+                        sensor_buffer[loopback.in.byte] &= ~loopback.in.bitmask;
+                    }
+                    if (motor_buffer[loopback.out.byte] & loopback.out.bitmask) {
+                        loopback_out_[l / 8] |= out_mask;
+                    } else {
+                        loopback_out_[l / 8] &= ~out_mask;
+                    }
+                }
+            }
+        }
+
+    private:
+        bool chainlink_;
+        uint8_t loopback_out_[(MAX_MODULES / 3 + 7) / 8 + 1];
+};
+
+#endif
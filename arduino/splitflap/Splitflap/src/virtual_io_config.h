@@ -0,0 +1,78 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef IO_CONFIG_H
+#define IO_CONFIG_H
+
+// IO backend for VIRTUAL_IO: the same chain as spi_io_config.h, but driving a VirtualBoard (see virtual_board.h)
+// instead of the shift registers, so the firmware can be run and load tested with no modules attached (or natively,
+// see bench/task_bench.cpp).
+
+#define BUFFER_ATTRS
+
+#define MOTOR_SENSOR_IO_ROUND_TRIP 2
+
+#include "module_chain.h"
+#include "virtual_board.h"
+
+#ifndef VIRTUAL_IO_SEED
+#define VIRTUAL_IO_SEED 1
+#endif
+
+VirtualBoard<NUM_MODULES> virtual_board;
+
+// Set by motor_sensor_io_set_clock(). Above VIRTUAL_IO_MAX_CLOCK_HZ, motor_sensor_io() reads the sensor inputs one bit
+// late, as a real chain does when it's clocked too fast for its wiring.
+uint32_t virtual_clock_hz = 0;
+
+// Whether virtual_board has been laid out. Its spools keep their positions if the task is restarted (as
+// bench/task_bench.cpp does to simulate a warm boot), as real ones do across a reboot.
+bool virtual_board_initialized = false;
+
+inline void initialize_modules() {
+  initialize_module_chain();
+  if (virtual_board_initialized) {
+    return;
+  }
+#ifdef CHAINLINK
+  virtual_board.Init(NUM_MODULES, true, VIRTUAL_IO_SEED);
+#else
+  virtual_board.Init(NUM_MODULES, false, VIRTUAL_IO_SEED);
+#endif
+  virtual_board_initialized = true;
+}
+
+inline void motor_sensor_io_wait() {
+}
+
+inline void motor_sensor_io() {
+  virtual_board.Update(motor_buffer, sensor_buffer);
+  if (virtual_clock_hz > VIRTUAL_IO_MAX_CLOCK_HZ) {
+    uint8_t extra_bit = 0;
+    for (uint8_t i = 0; i < SENSOR_BUFFER_LENGTH; i++) {
+      uint8_t val = sensor_buffer[i];
+      sensor_buffer[i] = (extra_bit << 7) | (val >> 1);
+      extra_bit = val & 1;
+    }
+  }
+  sensor_frame_received();
+}
+
+inline void motor_sensor_io_set_clock(uint32_t clock_hz) {
+  virtual_clock_hz = clock_hz;
+}
+
+#endif
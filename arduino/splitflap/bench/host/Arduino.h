@@ -0,0 +1,80 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+// Minimal stand-in for the Arduino core so that the splitflap motion code can be compiled and exercised natively
+// (see bench/splitflap_bench.cpp). Only what the Splitflap/src headers actually use is provided. Time is entirely
+// simulated: micros()/millis() return a fake clock that the host program advances explicitly.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+
+#define PROGMEM
+#define pgm_read_word_near(addr) (*(const uint16_t *)(addr))
+#define pgm_read_byte_near(addr) (*(const uint8_t *)(addr))
+#define pgm_read_dword_near(addr) (*(const uint32_t *)(addr))
+
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+
+#define B00000001 1
+#define B00000010 2
+#define B00000100 4
+#define B00001000 8
+
+typedef bool boolean;
+typedef std::string String;
+
+namespace FakeClock {
+    inline unsigned long& now_micros() {
+        static unsigned long now = 0;
+        return now;
+    }
+
+    inline void set(unsigned long micros) {
+        now_micros() = micros;
+    }
+
+    inline void advance(unsigned long delta_micros) {
+        now_micros() += delta_micros;
+    }
+}
+
+inline unsigned long micros() {
+    return FakeClock::now_micros();
+}
+
+inline unsigned long millis() {
+    return FakeClock::now_micros() / 1000;
+}
+
+class HostSerial {
+    public:
+        void print(const String& s) { fputs(s.c_str(), stdout); }
+        void print(const char* s) { fputs(s, stdout); }
+        void print(char c) { fputc(c, stdout); }
+        void print(long v) { printf("%ld", v); }
+        void print(unsigned long v) { printf("%lu", v); }
+        void print(int v) { printf("%d", v); }
+        void print(unsigned int v) { printf("%u", v); }
+        void println(const char* s) { puts(s); }
+        void flush() { fflush(stdout); }
+};
+
+// Defined once by each host program
+extern HostSerial Serial;
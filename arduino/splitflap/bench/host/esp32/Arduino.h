@@ -0,0 +1,195 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+// Stand-in for the parts of the ESP32 Arduino core and FreeRTOS that esp32/core/splitflap_task.cpp uses, on top of the
+// plain host Arduino.h, so that the whole task can run natively against the VIRTUAL_IO backend (see
+// bench/task_bench.cpp).
+//
+// Everything runs on the one host thread. xTaskCreatePinnedToCore() calls the task function directly, queues and
+// semaphores never block, and the task's watchdog reset at the end of each pass of its loop is where the host program
+// gets control back (see HostTask). Time is still the simulated clock: each pass advances it by
+// HostTask::pass_micros(), or with a frame timer running, each wait for the timer advances it by one timer period.
+
+#include "../Arduino.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <deque>
+#include <vector>
+
+#define IRAM_ATTR
+#define RTC_NOINIT_ATTR
+
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+#define INPUT 0
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_ERROR_CHECK(x) assert((x) == ESP_OK)
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void* TaskHandle_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define errQUEUE_FULL 0
+#define portMAX_DELAY 0xFFFFFFFF
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define portYIELD_FROM_ISR()
+
+namespace HostTask {
+    typedef void (*PassHook)();
+
+    // Called at the end of every pass of the task's loop
+    inline PassHook& pass_hook() {
+        static PassHook hook = nullptr;
+        return hook;
+    }
+
+    // Simulated time taken by one pass of the task's loop, when it isn't paced by a frame timer
+    inline unsigned long& pass_micros() {
+        static unsigned long micros = 100;
+        return micros;
+    }
+}
+
+inline void delay(uint32_t ms) {
+    FakeClock::advance(ms * 1000UL);
+}
+
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+inline void digitalWrite(uint8_t pin, uint8_t value) {}
+
+// Tasks
+
+inline BaseType_t xTaskCreatePinnedToCore(void (*task)(void*), const char* name, uint32_t stack_depth, void* params,
+        UBaseType_t priority, TaskHandle_t* handle, BaseType_t core_id) {
+    task(params);
+    return pdPASS;
+}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return nullptr;
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higher_priority_task_woken) {}
+
+// Hardware timer (one at a time), fired by ulTaskNotifyTake()
+
+struct hw_timer_t {
+    void (*isr)();
+    uint64_t alarm_micros;
+    bool enabled;
+};
+
+inline hw_timer_t* host_timer() {
+    static hw_timer_t timer = {};
+    return &timer;
+}
+
+inline hw_timer_t* timerBegin(uint8_t num, uint16_t divider, bool count_up) {
+    return host_timer();
+}
+
+inline void timerAttachInterrupt(hw_timer_t* timer, void (*isr)(), bool edge) {
+    timer->isr = isr;
+}
+
+inline void timerAlarmWrite(hw_timer_t* timer, uint64_t alarm_micros, bool auto_reload) {
+    timer->alarm_micros = alarm_micros;
+}
+
+inline void timerAlarmEnable(hw_timer_t* timer) {
+    timer->enabled = true;
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+    hw_timer_t* timer = host_timer();
+    assert(timer->enabled);
+    FakeClock::advance(timer->alarm_micros);
+    timer->isr();
+    return 1;
+}
+
+// Queues
+
+struct HostQueue {
+    uint32_t length;
+    uint32_t item_size;
+    std::deque<std::vector<uint8_t>> items;
+};
+typedef HostQueue* QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(uint32_t length, uint32_t item_size) {
+    return new HostQueue { length, item_size, {} };
+}
+
+inline void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+inline BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait) {
+    if (queue->items.size() >= queue->length) {
+        return errQUEUE_FULL;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    queue->items.push_back(std::vector<uint8_t>(bytes, bytes + queue->item_size));
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait) {
+    if (queue->items.empty()) {
+        return pdFALSE;
+    }
+    memcpy(item, queue->items.front().data(), queue->item_size);
+    queue->items.pop_front();
+    return pdTRUE;
+}
+
+// Semaphores
+
+struct HostSemaphore {
+    bool taken;
+};
+typedef HostSemaphore* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return new HostSemaphore { false };
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait) {
+    if (semaphore->taken) {
+        return pdFALSE;
+    }
+    semaphore->taken = true;
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    semaphore->taken = false;
+    return pdTRUE;
+}
@@ -0,0 +1,60 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include <map>
+#include <vector>
+
+// NVS stand-in, kept in memory for the life of the host program
+class Preferences {
+    public:
+        bool begin(const char* name, bool read_only = false) {
+            namespace_ = name;
+            return true;
+        }
+
+        void end() {}
+
+        size_t getBytesLength(const char* key) {
+            std::map<std::string, std::vector<uint8_t>>::iterator it = store().find(namespace_ + "/" + key);
+            return it == store().end() ? 0 : it->second.size();
+        }
+
+        size_t getBytes(const char* key, void* buf, size_t max_len) {
+            std::map<std::string, std::vector<uint8_t>>::iterator it = store().find(namespace_ + "/" + key);
+            if (it == store().end() || it->second.size() > max_len) {
+                return 0;
+            }
+            memcpy(buf, it->second.data(), it->second.size());
+            return it->second.size();
+        }
+
+        size_t putBytes(const char* key, const void* value, size_t len) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(value);
+            store()[namespace_ + "/" + key] = std::vector<uint8_t>(bytes, bytes + len);
+            return len;
+        }
+
+    private:
+        static std::map<std::string, std::vector<uint8_t>>& store() {
+            static std::map<std::string, std::vector<uint8_t>> values;
+            return values;
+        }
+
+        std::string namespace_;
+};
@@ -0,0 +1,34 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+inline esp_err_t esp_task_wdt_add(TaskHandle_t task) {
+    return ESP_OK;
+}
+
+// End of a pass of the task's loop: advance the simulated clock (unless a frame timer is pacing the loop) and hand
+// control to the host program
+inline esp_err_t esp_task_wdt_reset() {
+    if (!host_timer()->enabled) {
+        FakeClock::advance(HostTask::pass_micros());
+    }
+    if (HostTask::pass_hook() != nullptr) {
+        HostTask::pass_hook()();
+    }
+    return ESP_OK;
+}
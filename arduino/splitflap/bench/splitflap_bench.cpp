@@ -0,0 +1,983 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+// Host-native benchmark for the SplitflapModule motion kernel.
+//
+// Compiles splitflap_module.h and the SplitflapBatch engine (splitflap_batch.h) against a fake clock
+// (bench/host/Arduino.h) and fake motor/sensor buffers laid out like the chainlink shift register chain, then measures
+// the cost of Update(), GoToFlapIndex() and the homing paths for a range of chain lengths. A small simulated spool per
+// module turns the phase nibbles written to motor_buffer back into a position and drives the home sensor bit, so the
+// home calibration windows are exercised just like on hardware.
+//
+// Run with PlatformIO:
+//     pio run -e native-bench -t exec
+// or build directly:
+//     g++ -O2 -std=gnu++11 -Ibench/host -DSPLITFLAP_PIO_HARDWARE_CONFIG -DREVERSE_MOTOR_DIRECTION=false
+//         -DCHAINLINK -DNUM_MODULES=255 bench/splitflap_bench.cpp -o splitflap_bench
+//
+// Optional arguments are the module counts to benchmark (default: 6 through 255). Add -DFRAME_CLOCK=true (or use the
+// native-bench-frame environment) to benchmark frame-clocked stepping and check its step timing against the profile.
+//
+// Before benchmarking, it checks that:
+//   - the batch engine produces the same motor outputs and module state as plain SplitflapModules on every tick of
+//     the same homing/motion sequence
+//   - the active set engine (which skips idle modules like SplitflapTask does) matches them whenever a module comes
+//     to rest
+//   - the flap boundary tables match the division formulas for several gear ratios
+//   - both engines resume from a saved resting position after a simulated warm reboot
+//   - the chainlink IO layout tables have no overlapping bits
+//   - the home sensor glitch filter matches a per-input counter
+// The program exits with an error if any of these checks fail.
+//
+// Note that the numbers are host CPU timings; they are useful for comparing changes to the motion code and for seeing
+// how cost scales with chain length, but an ESP32 core will be considerably slower in absolute terms.
+
+#include <Arduino.h>
+
+#include <stdlib.h>
+
+#include <chrono>
+#include <new>
+
+#include "../Splitflap/config.h"
+#include "../Splitflap/src/splitflap_module.h"
+#include "../Splitflap/src/splitflap_batch.h"
+#include "../Splitflap/src/active_module_set.h"
+#include "../Splitflap/src/io_layout.h"
+#include "../Splitflap/src/sensor_debounce.h"
+#include "../Splitflap/src/sensor_edge_latch.h"
+#include "../Splitflap/src/virtual_board.h"
+
+HostSerial Serial;
+
+#define BENCH_MAX_MODULES 255
+
+// Simulated time between two iterations of the update loop, and the time base passed to Update(). With FRAME_CLOCK
+// the loop runs once per frame and modules are updated with the frame count.
+#if FRAME_CLOCK
+#define SIM_TICK_MICROS ((unsigned int)Acceleration::FRAME_PERIOD_MICROS)
+#define SIM_NOW() (micros() / Acceleration::FRAME_PERIOD_MICROS)
+#else
+#define SIM_TICK_MICROS 100
+#define SIM_NOW() micros()
+#endif
+
+#define MOVE_TICKS 20000
+#define IDLE_TICKS 20000
+#define MAX_HOME_TICKS 200000
+#define CROSS_CHECK_TICKS 200000
+
+#define CHAIN_MOTOR_BUFFER_LENGTH(n) IoLayout::MotorBufferLength(n, true)
+#define CHAIN_SENSOR_BUFFER_LENGTH(n) IoLayout::SensorBufferLength(n, true)
+
+// Fake motor_buffer/sensor_buffer for a chainlink chain, with a simulated spool for each module (see
+// src/virtual_board.h).
+struct Chain : VirtualBoard<BENCH_MAX_MODULES> {
+    uint8_t motor_buffer[CHAIN_MOTOR_BUFFER_LENGTH(BENCH_MAX_MODULES)];
+    uint8_t sensor_buffer[CHAIN_SENSOR_BUFFER_LENGTH(BENCH_MAX_MODULES)];
+#if SENSOR_DEBOUNCE_FRAMES > 1
+    SensorDebounce<CHAIN_SENSOR_BUFFER_LENGTH(BENCH_MAX_MODULES), SENSOR_DEBOUNCE_FRAMES, 6> sensor_debounce;
+#endif
+#if SENSOR_EDGE_LATCH
+    uint8_t sensor_edges[CHAIN_SENSOR_BUFFER_LENGTH(BENCH_MAX_MODULES)];
+    uint8_t sensor_last[CHAIN_SENSOR_BUFFER_LENGTH(BENCH_MAX_MODULES)];
+#endif
+
+    void init(uint8_t count, unsigned int seed) {
+        memset(motor_buffer, 0, sizeof(motor_buffer));
+        memset(sensor_buffer, 0, sizeof(sensor_buffer));
+#if SENSOR_DEBOUNCE_FRAMES > 1
+        sensor_debounce = SensorDebounce<CHAIN_SENSOR_BUFFER_LENGTH(BENCH_MAX_MODULES), SENSOR_DEBOUNCE_FRAMES, 6>();
+#endif
+#if SENSOR_EDGE_LATCH
+        memset(sensor_edges, 0, sizeof(sensor_edges));
+        memset(sensor_last, 0, sizeof(sensor_last));
+#endif
+        Init(count, true, seed);
+        simulate();
+    }
+
+    // Stand-in for motor_sensor_io()
+    void simulate() {
+        Update(motor_buffer, sensor_buffer);
+#if SENSOR_DEBOUNCE_FRAMES > 1
+        sensor_debounce.Filter(sensor_buffer);
+#endif
+#if SENSOR_EDGE_LATCH
+        LatchSensorEdges(sensor_buffer, sensor_last, sensor_edges, CHAIN_SENSOR_BUFFER_LENGTH(num_modules));
+#endif
+    }
+};
+
+// One SplitflapModule instance per module, each holding references into the chain's buffers (as initialize_modules()
+// sets them up in spi_io_config.h).
+class ModuleEngine {
+    public:
+        static const char* name() { return "module"; }
+
+        void attach(Chain& chain) {
+            for (uint8_t i = 0; i < chain.num_modules; i++) {
+                VirtualSpool& spool = chain.spools[i];
+                modules_[i] = new (module_buffer_[i]) SplitflapModule(
+                    chain.motor_buffer[spool.motor_byte], spool.motor_shift,
+                    chain.sensor_buffer[spool.sensor_byte], spool.sensor_mask
+#if SENSOR_EDGE_LATCH
+                    , chain.sensor_edges[spool.sensor_byte]
+#endif
+                    );
+            }
+            num_modules_ = chain.num_modules;
+        }
+
+        void update() {
+            unsigned long now = SIM_NOW();
+            for (uint8_t i = 0; i < num_modules_; i++) {
+                modules_[i]->Update(now);
+            }
+        }
+
+        // Called after any command is sent to module i
+        void wake(uint8_t i) {}
+
+        SplitflapModule& operator[](uint8_t i) { return *modules_[i]; }
+
+    private:
+        uint8_t num_modules_ = 0;
+        char module_buffer_[BENCH_MAX_MODULES][sizeof(SplitflapModule)];
+        SplitflapModule* modules_[BENCH_MAX_MODULES];
+};
+
+// All modules in a single SplitflapBatch, addressed through SplitflapBatchModuleT views.
+class BatchEngine {
+    public:
+        typedef SplitflapBatchModuleT<BENCH_MAX_MODULES> Module;
+
+        static const char* name() { return "batch"; }
+
+        void attach(Chain& chain) {
+#if SENSOR_EDGE_LATCH
+            batch_ = new (batch_buffer_) SplitflapBatch<BENCH_MAX_MODULES>(chain.motor_buffer, chain.sensor_buffer, chain.sensor_edges);
+#else
+            batch_ = new (batch_buffer_) SplitflapBatch<BENCH_MAX_MODULES>(chain.motor_buffer, chain.sensor_buffer);
+#endif
+            for (uint8_t i = 0; i < chain.num_modules; i++) {
+                VirtualSpool& spool = chain.spools[i];
+                batch_->AttachModule(i, spool.motor_byte, spool.motor_shift, spool.sensor_byte, spool.sensor_mask);
+                modules_[i] = new (module_buffer_[i]) Module(*batch_, i);
+            }
+        }
+
+        void update() {
+            batch_->Update(SIM_NOW());
+        }
+
+        void wake(uint8_t i) {}
+
+        Module& operator[](uint8_t i) { return *modules_[i]; }
+
+    private:
+        alignas(SplitflapBatch<BENCH_MAX_MODULES>) char batch_buffer_[sizeof(SplitflapBatch<BENCH_MAX_MODULES>)];
+        SplitflapBatch<BENCH_MAX_MODULES>* batch_;
+        char module_buffer_[BENCH_MAX_MODULES][sizeof(Module)];
+        Module* modules_[BENCH_MAX_MODULES];
+};
+
+// SplitflapModule instances updated through an ActiveModuleSet, as SplitflapTask::runUpdate() does: idle modules are
+// skipped until they're commanded or their home sensor input changes.
+class ActiveSetEngine {
+    public:
+        static const char* name() { return "active"; }
+
+        void attach(Chain& chain) {
+            engine_.attach(chain);
+            chain_ = &chain;
+            active_ = ActiveModuleSet<BENCH_MAX_MODULES>();
+            active_.AddAll(chain.num_modules);
+            memcpy(last_sensor_buffer_, chain.sensor_buffer, sizeof(last_sensor_buffer_));
+        }
+
+        void update() {
+            unsigned long now = SIM_NOW();
+            for (int16_t n = active_.Size() - 1; n >= 0; n--) {
+                uint8_t i = active_[n];
+                engine_[i].Update(now);
+                if (engine_[i].IsIdle()) {
+                    active_.RemoveAt(n);
+                }
+            }
+            // Sensor changes from the previous simulate() call
+            active_.AddSensorChanges(chain_->sensor_buffer, last_sensor_buffer_,
+                CHAIN_SENSOR_BUFFER_LENGTH(chain_->num_modules), 6, chain_->num_modules);
+        }
+
+        void wake(uint8_t i) {
+            active_.Add(i);
+        }
+
+        SplitflapModule& operator[](uint8_t i) { return engine_[i]; }
+
+    private:
+        ModuleEngine engine_;
+        Chain* chain_;
+        ActiveModuleSet<BENCH_MAX_MODULES> active_;
+        uint8_t last_sensor_buffer_[CHAIN_SENSOR_BUFFER_LENGTH(BENCH_MAX_MODULES)];
+};
+
+typedef std::chrono::steady_clock BenchClock;
+
+struct PhaseResult {
+    uint32_t ticks = 0;
+    uint64_t total_ns = 0;
+    uint64_t worst_ns = 0;
+
+    void add(uint64_t ns) {
+        ticks++;
+        total_ns += ns;
+        if (ns > worst_ns) {
+            worst_ns = ns;
+        }
+    }
+};
+
+static Chain chain;
+static Chain reference_chain;
+static ModuleEngine module_engine;
+static ModuleEngine reference_engine;
+static BatchEngine batch_engine;
+static ActiveSetEngine active_engine;
+
+template <class Engine>
+static uint64_t updateChain(Engine& engine, Chain& chain) {
+    BenchClock::time_point start = BenchClock::now();
+    engine.update();
+    uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start).count();
+
+    chain.simulate();
+    return elapsed;
+}
+
+template <class Engine>
+static bool allStopped(Engine& engine, uint8_t num_modules) {
+    for (uint8_t i = 0; i < num_modules; i++) {
+        if (engine[i].state == LOOK_FOR_HOME || engine[i].current_accel_step != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void printResult(const char* engine, const char* phase, uint8_t num_modules, const PhaseResult& result) {
+    double ns_per_tick = result.ticks > 0 ? (double)result.total_ns / result.ticks : 0;
+    double ns_per_module = ns_per_tick / num_modules;
+    printf("%-7s %-6s %7u %10u %14.1f %14.0f %12.2f\n",
+        engine,
+        phase,
+        num_modules,
+        result.ticks,
+        ns_per_module,
+        ns_per_tick > 0 ? 1e9 / ns_per_tick : 0,
+        result.worst_ns / 1000.0);
+}
+
+template <class Engine>
+static void runBenchmark(Engine& engine, uint8_t num_modules) {
+    FakeClock::set(0);
+    chain.init(num_modules, num_modules);
+    engine.attach(chain);
+
+    // Homing: every module starts from a random spool position and searches for its home flag
+    PhaseResult home;
+    for (uint8_t i = 0; i < num_modules; i++) {
+        engine[i].Init();
+        engine[i].GoHome();
+        engine.wake(i);
+    }
+    while (home.ticks < MAX_HOME_TICKS) {
+        home.add(updateChain(engine, chain));
+        FakeClock::advance(SIM_TICK_MICROS);
+        if (allStopped(engine, num_modules)) {
+            break;
+        }
+    }
+    printResult(Engine::name(), "home", num_modules, home);
+
+    // Moving: keep every module in motion by handing out a new random target as soon as the previous one is reached.
+    // This also exercises the expected/unexpected home windows once per revolution.
+    PhaseResult move;
+    uint32_t go_to_calls = 0;
+    uint64_t go_to_ns = 0;
+    for (uint32_t t = 0; t < MOVE_TICKS; t++) {
+        for (uint8_t i = 0; i < num_modules; i++) {
+            if (engine[i].current_accel_step == 0) {
+                uint8_t target = rand() % NUM_FLAPS;
+                BenchClock::time_point start = BenchClock::now();
+                engine[i].GoToFlapIndex(target);
+                engine.wake(i);
+                go_to_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start).count();
+                go_to_calls++;
+            }
+        }
+        move.add(updateChain(engine, chain));
+        FakeClock::advance(SIM_TICK_MICROS);
+    }
+    printResult(Engine::name(), "move", num_modules, move);
+
+    // Idle: let everything come to rest, then measure the cost of a chain that has nothing to do
+    while (!allStopped(engine, num_modules)) {
+        updateChain(engine, chain);
+        FakeClock::advance(SIM_TICK_MICROS);
+    }
+    PhaseResult idle;
+    for (uint32_t t = 0; t < IDLE_TICKS; t++) {
+        idle.add(updateChain(engine, chain));
+        FakeClock::advance(SIM_TICK_MICROS);
+    }
+    printResult(Engine::name(), "idle", num_modules, idle);
+
+    uint16_t errors = 0;
+    for (uint8_t i = 0; i < num_modules; i++) {
+        errors += engine[i].count_missed_home + engine[i].count_unexpected_home;
+        if (engine[i].state != NORMAL) {
+            errors++;
+        }
+    }
+    printf("               GoToFlapIndex: %.1f ns/call over %u calls; home errors: %u\n",
+        go_to_calls > 0 ? (double)go_to_ns / go_to_calls : 0,
+        go_to_calls,
+        errors);
+}
+
+// Drive SplitflapModule and SplitflapBatch through an identical sequence of commands and require identical motor
+// output and module state on every tick. The sequence includes homing, random moves issued both while stopped and
+// while moving, occasional re-homing and slipped spools (to trigger missed/unexpected home recalibration).
+static bool crossCheck(uint8_t num_modules) {
+    FakeClock::set(0);
+    reference_chain.init(num_modules, 1000 + num_modules);
+    chain.init(num_modules, 1000 + num_modules);
+    reference_engine.attach(reference_chain);
+    batch_engine.attach(chain);
+
+    for (uint8_t i = 0; i < num_modules; i++) {
+        reference_engine[i].Init();
+        reference_engine[i].GoHome();
+        batch_engine[i].Init();
+        batch_engine[i].GoHome();
+    }
+
+    srand(num_modules);
+    for (uint32_t t = 0; t < CROSS_CHECK_TICKS; t++) {
+        uint8_t i = rand() % num_modules;
+        switch (rand() % 64) {
+            case 0: {
+                uint8_t target = rand() % NUM_FLAPS;
+                reference_engine[i].GoToFlapIndex(target);
+                batch_engine[i].GoToFlapIndex(target);
+                break;
+            }
+            case 1:
+                if (rand() % 64 == 0) {
+                    reference_engine[i].ResetState();
+                    reference_engine[i].GoHome();
+                    batch_engine[i].ResetState();
+                    batch_engine[i].GoHome();
+                }
+                break;
+            case 2:
+                if (rand() % 16 == 0) {
+                    // Slip the spool by a few flaps
+                    uint32_t slip = rand() % (_ROUGH_STEPS_PER_FLAP * 8);
+                    reference_chain.spools[i].position = (reference_chain.spools[i].position + slip) % VIRTUAL_SPOOL_REVOLUTION_STEPS;
+                    chain.spools[i].position = (chain.spools[i].position + slip) % VIRTUAL_SPOOL_REVOLUTION_STEPS;
+                }
+                break;
+            case 3: {
+                // Profile changes may arrive mid-move; they must only take effect once the module has stopped
+                uint8_t profile = rand() % Acceleration::NUM_MOTION_PROFILES;
+                reference_engine[i].SetMotionProfile(profile);
+                batch_engine[i].SetMotionProfile(profile);
+                break;
+            }
+#if SPEED_CALIBRATION
+            case 4: {
+                // Speed caps may also change mid-move, e.g. between calibration passes
+                uint16_t min_period = ACCEL_CALIBRATION_MIN_PERIOD_MICROS + rand() % ACCEL_MIN_PERIOD_MICROS;
+                reference_engine[i].SetMinStepPeriod(min_period);
+                batch_engine[i].SetMinStepPeriod(min_period);
+                break;
+            }
+#endif
+            default:
+                break;
+        }
+
+        reference_engine.update();
+        batch_engine.update();
+        reference_chain.simulate();
+        chain.simulate();
+        FakeClock::advance(SIM_TICK_MICROS);
+
+        if (memcmp(reference_chain.motor_buffer, chain.motor_buffer, sizeof(chain.motor_buffer)) != 0) {
+            printf("Cross-check FAILED for %u modules: motor output differs at tick %u\n", num_modules, t);
+            return false;
+        }
+        for (uint8_t m = 0; m < num_modules; m++) {
+            if (reference_engine[m].state != batch_engine[m].state
+                    || reference_engine[m].current_accel_step != batch_engine[m].current_accel_step
+                    || reference_engine[m].GetCurrentFlapIndex() != batch_engine[m].GetCurrentFlapIndex()
+                    || reference_engine[m].GetTargetFlapIndex() != batch_engine[m].GetTargetFlapIndex()
+                    || reference_engine[m].count_missed_home != batch_engine[m].count_missed_home
+                    || reference_engine[m].count_unexpected_home != batch_engine[m].count_unexpected_home
+                    || reference_engine[m].IsIdle() != batch_engine[m].IsIdle()
+                    || reference_engine[m].GetMotionProfile() != batch_engine[m].GetMotionProfile()) {
+                printf("Cross-check FAILED for %u modules: module %u state differs at tick %u\n", num_modules, m, t);
+                return false;
+            }
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+            HomeCalibration expected = reference_engine[m].GetHomeCalibration();
+            HomeCalibration actual = batch_engine[m].GetHomeCalibration();
+            if (expected.offset != actual.offset || expected.spread != actual.spread || expected.samples != actual.samples) {
+                printf("Cross-check FAILED for %u modules: module %u home calibration differs at tick %u\n", num_modules, m, t);
+                return false;
+            }
+#endif
+#if STEP_TIMING_STATS
+            StepTimingStats expected_timing = reference_engine[m].GetStepTimingStats();
+            StepTimingStats actual_timing = batch_engine[m].GetStepTimingStats();
+            if (memcmp(&expected_timing, &actual_timing, sizeof(StepTimingStats)) != 0) {
+                printf("Cross-check FAILED for %u modules: module %u step timing stats differ at tick %u\n", num_modules, m, t);
+                return false;
+            }
+#endif
+        }
+    }
+    return true;
+}
+
+// Check that skipping idle modules (ActiveSetEngine) doesn't change the outcome of any command. A woken module takes
+// its first step immediately rather than at the end of an idle step period, so motor output isn't tick-for-tick
+// identical to updating every module; instead, commands and spool slips are only applied to modules that are at rest
+// in both engines, and the resulting module state is compared whenever a module is at rest in both again.
+static bool crossCheckActiveSet(uint8_t num_modules) {
+    FakeClock::set(0);
+    reference_chain.init(num_modules, 2000 + num_modules);
+    chain.init(num_modules, 2000 + num_modules);
+    reference_engine.attach(reference_chain);
+    active_engine.attach(chain);
+
+    for (uint8_t i = 0; i < num_modules; i++) {
+        reference_engine[i].Init();
+        reference_engine[i].GoHome();
+        active_engine[i].Init();
+        active_engine[i].GoHome();
+        active_engine.wake(i);
+    }
+
+    srand(num_modules);
+    for (uint32_t t = 0; t < CROSS_CHECK_TICKS; t++) {
+        uint8_t i = rand() % num_modules;
+        if (reference_engine[i].IsIdle() && active_engine[i].IsIdle()) {
+            switch (rand() % 16) {
+                case 0: {
+                    uint8_t target = rand() % NUM_FLAPS;
+                    reference_engine[i].GoToFlapIndex(target);
+                    active_engine[i].GoToFlapIndex(target);
+                    active_engine.wake(i);
+                    break;
+                }
+                case 1:
+                    if (rand() % 16 == 0) {
+                        reference_engine[i].ResetState();
+                        reference_engine[i].GoHome();
+                        active_engine[i].ResetState();
+                        active_engine[i].GoHome();
+                        active_engine.wake(i);
+                    }
+                    break;
+                case 2: {
+                    // Slip the spool by a few flaps; may move the home flag onto or off the sensor while the module is
+                    // idle, which only the sensor change detection will notice
+                    uint32_t slip = rand() % (_ROUGH_STEPS_PER_FLAP * 8);
+                    reference_chain.spools[i].position = (reference_chain.spools[i].position + slip) % VIRTUAL_SPOOL_REVOLUTION_STEPS;
+                    chain.spools[i].position = (chain.spools[i].position + slip) % VIRTUAL_SPOOL_REVOLUTION_STEPS;
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        reference_engine.update();
+        active_engine.update();
+        reference_chain.simulate();
+        chain.simulate();
+        FakeClock::advance(SIM_TICK_MICROS);
+
+        for (uint8_t m = 0; m < num_modules; m++) {
+            if (!reference_engine[m].IsIdle() || !active_engine[m].IsIdle()) {
+                continue;
+            }
+            if (reference_engine[m].state != active_engine[m].state
+                    || reference_engine[m].GetCurrentFlapIndex() != active_engine[m].GetCurrentFlapIndex()
+                    || reference_engine[m].GetTargetFlapIndex() != active_engine[m].GetTargetFlapIndex()
+                    || reference_engine[m].count_missed_home != active_engine[m].count_missed_home
+                    || reference_engine[m].count_unexpected_home != active_engine[m].count_unexpected_home
+                    || reference_chain.spools[m].position != chain.spools[m].position) {
+                printf("Active set cross-check FAILED for %u modules: module %u differs at rest at tick %u\n", num_modules, m, t);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <class Engine>
+static bool runUntilIdle(Engine& engine, uint8_t num_modules) {
+    for (uint32_t t = 0; t < MAX_HOME_TICKS; t++) {
+        engine.update();
+        chain.simulate();
+        FakeClock::advance(SIM_TICK_MICROS);
+
+        bool idle = true;
+        for (uint8_t i = 0; i < num_modules; i++) {
+            idle &= engine[i].IsIdle();
+        }
+        if (idle) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Warm boot resume: bring a chain to rest on random flaps, "reboot" it (fresh module instances over the same chain,
+// whose spools stay where they are), resume every module from its resting position and keep sending it around.
+// Resumed modules must pass the following home checks without recalibrating, and a spool that slipped while the
+// firmware was down must be caught by them.
+template <class Engine>
+static bool checkWarmResume(Engine& engine) {
+    const uint8_t num_modules = 12;
+    const uint8_t slipped = 5;
+    ModulePosition positions[num_modules];
+
+    FakeClock::set(0);
+    chain.init(num_modules, 3000);
+    engine.attach(chain);
+    srand(3000);
+    for (uint8_t i = 0; i < num_modules; i++) {
+        engine[i].Init();
+        engine[i].GoHome();
+    }
+    runUntilIdle(engine, num_modules);
+    for (uint8_t i = 0; i < num_modules; i++) {
+        engine[i].GoToFlapIndex(rand() % NUM_FLAPS);
+    }
+    runUntilIdle(engine, num_modules);
+    for (uint8_t i = 0; i < num_modules; i++) {
+        if (!engine[i].GetRestingPosition(positions[i])) {
+            printf("Warm resume check FAILED (%s): module %u has no resting position\n", Engine::name(), i);
+            return false;
+        }
+    }
+
+    chain.spools[slipped].position = (chain.spools[slipped].position + 3 * _ROUGH_STEPS_PER_FLAP) % VIRTUAL_SPOOL_REVOLUTION_STEPS;
+    engine.attach(chain);
+    for (uint8_t i = 0; i < num_modules; i++) {
+        engine[i].Init();
+        if (!engine[i].ResumeAt(positions[i])) {
+            printf("Warm resume check FAILED (%s): module %u did not resume\n", Engine::name(), i);
+            return false;
+        }
+    }
+
+    for (uint8_t move = 0; move < 8; move++) {
+        for (uint8_t i = 0; i < num_modules; i++) {
+            engine[i].GoToFlapIndex(rand() % NUM_FLAPS);
+        }
+        runUntilIdle(engine, num_modules);
+    }
+    for (uint8_t i = 0; i < num_modules; i++) {
+        // Without home calibration there are no home checks to catch the slip
+        bool should_recalibrate = HOME_CALIBRATION_ENABLED && i == slipped;
+        bool recalibrated = engine[i].count_missed_home + engine[i].count_unexpected_home > 0;
+        if (recalibrated != should_recalibrate || engine[i].state != NORMAL
+                || engine[i].GetCurrentFlapIndex() != engine[i].GetTargetFlapIndex()) {
+            printf("Warm resume check FAILED (%s): module %u %s after resuming\n", Engine::name(), i,
+                should_recalibrate ? "missed its slip" : "lost its position");
+            return false;
+        }
+    }
+    printf("Warm resume (%s): %u modules resumed without homing, slipped spool caught\n", Engine::name(), num_modules);
+    return true;
+}
+
+#if SPEED_CALIBRATION
+// Send a module capped with SetMinStepPeriod most of the way around on the FAST profile (whose ramp runs on past the
+// cap) and time its steps: none may be faster than the cap, but it should get within a tick of it.
+template <class Engine>
+static bool checkSpeedCap(Engine& engine) {
+    const uint16_t cap = ACCEL_CALIBRATION_MIN_PERIOD_MICROS + 3 * ACCEL_CALIBRATION_PERIOD_STEP_MICROS;
+
+    FakeClock::set(0);
+    chain.init(1, 1);
+    engine.attach(chain);
+    engine[0].SetMotionProfile(Acceleration::MOTION_PROFILE_FAST);
+    engine[0].SetMinStepPeriod(cap);
+    engine[0].Init();
+    engine[0].GoHome();
+    runUntilIdle(engine, 1);
+    engine[0].GoToFlapIndex((engine[0].GetCurrentFlapIndex() + NUM_FLAPS - 1) % NUM_FLAPS);
+
+    uint32_t position = chain.spools[0].position;
+    uint32_t last_step_micros = 0;
+    uint32_t fastest = UINT32_MAX;
+    uint32_t steps = 0;
+    for (uint32_t t = 0; t < MAX_HOME_TICKS && !engine[0].IsIdle(); t++) {
+        engine.update();
+        chain.simulate();
+        if (chain.spools[0].position != position) {
+            if (steps > 0 && micros() - last_step_micros < fastest) {
+                fastest = micros() - last_step_micros;
+            }
+            position = chain.spools[0].position;
+            last_step_micros = micros();
+            steps++;
+        }
+        FakeClock::advance(SIM_TICK_MICROS);
+    }
+    if (fastest < cap || fastest >= cap + SIM_TICK_MICROS + ACCEL_CALIBRATION_PERIOD_STEP_MICROS) {
+        printf("Speed cap check FAILED (%s): fastest step took %u us with a %u us cap\n", Engine::name(), fastest, cap);
+        return false;
+    }
+    printf("Speed cap (%s): fastest of %u steps took %u us with a %u us cap\n", Engine::name(), steps, fastest, cap);
+    return true;
+}
+#endif
+
+#if FRAME_CLOCK
+// Enough for a full revolution at up to 10 frames per step
+#define FRAME_TIMING_MAX_FRAMES (VIRTUAL_SPOOL_REVOLUTION_STEPS * 10)
+
+// Home a single module using the given motion profile, then send it around one full revolution, updating it between 1
+// and max_passes_per_frame times per frame (as a loop with a varying amount of other work to do might). Records the
+// frame of every step.
+static uint16_t runTimedRevolution(uint8_t profile, uint8_t max_passes_per_frame, uint32_t* step_frames, uint16_t max_steps) {
+    FakeClock::set(0);
+    chain.init(1, 1);
+    module_engine.attach(chain);
+    SplitflapModule& module = module_engine[0];
+    VirtualSpool& spool = chain.spools[0];
+
+    srand(max_passes_per_frame);
+    module.SetMotionProfile(profile);
+    module.Init();
+    module.GoHome();
+    uint32_t frame = 0;
+    for (; frame < MAX_HOME_TICKS && !(module.state == NORMAL && module.IsIdle()); frame++) {
+        module.Update(frame);
+        chain.simulate();
+    }
+
+    module.GoToFlapIndex(module.GetCurrentFlapIndex());
+    uint16_t num_steps = 0;
+    uint8_t last_pattern = (chain.motor_buffer[spool.motor_byte] >> spool.motor_shift) & 0x0F;
+    uint32_t end_frame = frame + FRAME_TIMING_MAX_FRAMES;
+    for (; frame < end_frame && !module.IsIdle(); frame++) {
+        uint8_t passes = 1 + rand() % max_passes_per_frame;
+        for (uint8_t p = 0; p < passes; p++) {
+            module.Update(frame);
+        }
+        chain.simulate();
+
+        uint8_t pattern = (chain.motor_buffer[spool.motor_byte] >> spool.motor_shift) & 0x0F;
+        if (pattern != 0 && pattern != last_pattern && num_steps < max_steps) {
+            step_frames[num_steps++] = frame;
+        }
+        last_pattern = pattern;
+    }
+    return num_steps;
+}
+
+// With FRAME_CLOCK, step timing must follow the module's motion profile exactly: for a move of D steps, step j
+// (1-based) is taken at accel step min(j, max_accel_step, D - j + 1), and the next step follows exactly
+// periods[that accel step] frames later, no matter how often the update loop runs within a frame. With
+// SPEED_CALIBRATION, max_accel_step is where the module's default speed cap truncates the profile.
+static bool verifyFrameTiming() {
+    static uint32_t step_frames[GEAR_RATIO_INPUT_STEPS];
+    static const uint8_t PASSES_PER_FRAME[] = {1, 3};
+
+    for (uint8_t p = 0; p < Acceleration::NUM_MOTION_PROFILES; p++) {
+        const Acceleration::MotionProfile& profile = Acceleration::MOTION_PROFILES[p];
+#if SPEED_CALIBRATION
+        uint8_t max_accel_step = Acceleration::MaxAccelStepForMinPeriod(profile, ACCEL_FAST_MIN_PERIOD_MICROS);
+#else
+        uint8_t max_accel_step = profile.max_accel_step;
+#endif
+        for (uint8_t k = 0; k < sizeof(PASSES_PER_FRAME); k++) {
+            uint16_t num_steps = runTimedRevolution(p, PASSES_PER_FRAME[k], step_frames, GEAR_RATIO_INPUT_STEPS);
+            if (num_steps < VIRTUAL_SPOOL_REVOLUTION_STEPS) {
+                printf("Frame timing check FAILED: only %u steps recorded for a full revolution (profile %u)\n", num_steps, p);
+                return false;
+            }
+            for (uint16_t j = 1; j < num_steps; j++) {
+                uint16_t accel_step = j;
+                if (accel_step > max_accel_step) {
+                    accel_step = max_accel_step;
+                }
+                if (accel_step > num_steps - j + 1) {
+                    accel_step = num_steps - j + 1;
+                }
+                uint32_t expected_frame = step_frames[j - 1] + ACCEL_STEP_PERIOD(profile, accel_step);
+                if (step_frames[j] != expected_frame) {
+                    printf("Frame timing check FAILED: step %u at frame %u, expected %u (profile %u, up to %u passes per frame)\n",
+                        j + 1, step_frames[j], expected_frame, p, PASSES_PER_FRAME[k]);
+                    return false;
+                }
+            }
+            printf("Frame timing: %u steps match motion profile %u exactly (up to %u passes per frame)\n",
+                num_steps, p, PASSES_PER_FRAME[k]);
+        }
+    }
+    return true;
+}
+#endif
+
+// FlapBoundaries replaces the flap floor/target step divisions that SplitflapModule used to do on every move (and
+// that SplitflapBatch still does). Check it against those formulas for every position, target and home search over
+// a full cycle, walking the position forwards the same way SplitflapModule tracks it, for a few gear ratios.
+template <uint32_t IN, uint16_t OUT, uint8_t FLAPS>
+static bool checkFlapBoundaries() {
+    typedef FlapBoundaries<IN, OUT, FLAPS> Boundaries;
+
+    uint8_t flap = 0;
+    uint8_t flap_index = 0;
+    uint32_t next_flap_step = Boundaries::StepForFlap(1);
+    for (uint32_t step = 0; step < IN; step++) {
+        if (step == next_flap_step) {
+            flap++;
+            flap_index = (flap_index + 1) % FLAPS;
+            next_flap_step = Boundaries::StepForFlap(flap + 1);
+        }
+        uint8_t expected_flap = (uint64_t)step * OUT / IN;
+        if (flap != expected_flap || flap_index != expected_flap % FLAPS) {
+            printf("Flap boundary check FAILED (%u/%u): flap %u at step %u, expected %u\n", IN, OUT, flap, step, expected_flap);
+            return false;
+        }
+        for (uint8_t target = 0; target < FLAPS; target++) {
+            uint8_t delta_flaps = target > flap_index ? target - flap_index : FLAPS + target - flap_index;
+            uint32_t expected_step = ((uint64_t)(flap + delta_flaps) * IN + OUT - 1) / OUT;
+            uint32_t target_step = target == 0 ? Boundaries::NextHomeStep(step) : Boundaries::TargetStep(flap, flap_index, target);
+            if (target_step != expected_step) {
+                printf("Flap boundary check FAILED (%u/%u): step %u to flap %u gives %u, expected %u\n",
+                    IN, OUT, step, target, target_step, expected_step);
+                return false;
+            }
+        }
+    }
+    if (next_flap_step != IN || flap != OUT - 1) {
+        printf("Flap boundary check FAILED (%u/%u): cycle ends at step %u\n", IN, OUT, next_flap_step);
+        return false;
+    }
+    printf("Flap boundaries: %u steps / %u flaps match the division formulas\n", IN, OUT);
+    return true;
+}
+
+// Every motor phase, LED and loopback output of a chainlink chain must have its own bit of motor_buffer, and every
+// home sensor and loopback input its own bit of sensor_buffer. Check the IoLayout tables assign them that way for
+// every chain length.
+static bool markBit(uint8_t* used, uint8_t length, uint8_t byte, uint8_t bitmask) {
+    if (byte >= length || (used[byte] & bitmask) != 0) {
+        return false;
+    }
+    used[byte] |= bitmask;
+    return true;
+}
+
+// Checks one chain length, split into two chains after `split` modules (split == n for a single chain)
+static bool checkIoLayout(uint8_t n, uint8_t split) {
+    uint8_t motor_length = split < n
+        ? IoLayout::SplitMotorOffset(split, true) + CHAIN_MOTOR_BUFFER_LENGTH(n - split)
+        : CHAIN_MOTOR_BUFFER_LENGTH(n);
+    uint8_t sensor_length = CHAIN_SENSOR_BUFFER_LENGTH(n);
+    uint8_t motor_used[CHAIN_MOTOR_BUFFER_LENGTH(BENCH_MAX_MODULES) + 3] = {};
+    uint8_t sensor_used[CHAIN_SENSOR_BUFFER_LENGTH(BENCH_MAX_MODULES)] = {};
+    bool ok = true;
+    for (uint8_t i = 0; i < n; i++) {
+        IoLayout::ModuleIo io = IoLayout::SplitModule(n, true, split, i);
+        IoLayout::BufferBit led = IoLayout::SplitChainlinkLed(n, split, i);
+        ok = ok
+            && markBit(motor_used, motor_length, io.motor_byte, 0x0F << io.motor_bitshift)
+            && markBit(sensor_used, sensor_length, io.sensor_byte, io.sensor_bitmask)
+            && io.sensor_byte == i / 6 && io.sensor_bitmask == 1 << (i % 6)
+            && markBit(motor_used, motor_length, led.byte, led.bitmask);
+    }
+    for (uint8_t i = 0; i < n / 3; i++) {
+        IoLayout::LoopbackIo loopback = IoLayout::SplitChainlinkLoopback(n, split, i);
+        ok = ok
+            && markBit(motor_used, motor_length, loopback.out.byte, loopback.out.bitmask)
+            && markBit(sensor_used, sensor_length, loopback.in.byte, loopback.in.bitmask);
+    }
+    if (!ok) {
+        printf("IO layout check FAILED: overlapping or out of range bits for %u modules split after %u\n", n, split);
+    }
+    return ok;
+}
+
+static bool checkIoLayout() {
+    for (uint16_t n = 1; n <= BENCH_MAX_MODULES; n++) {
+        if (!checkIoLayout(n, n)) {
+            return false;
+        }
+        for (uint16_t split = 6; split < n; split += 6) {
+            if (!checkIoLayout(n, split)) {
+                return false;
+            }
+        }
+    }
+    printf("IO layout: chainlink bits are distinct for every chain length (and split) up to %u modules\n",
+        BENCH_MAX_MODULES);
+    return true;
+}
+
+// Runs SensorDebounce over a full 255 module chain with random inputs (mostly steady, with frequent single-frame
+// glitches and occasional real changes) and checks every home sensor against a per-input counter, and that the
+// loopback inputs pass through untouched. Also times the filter, since it runs on every motor_sensor_io() frame.
+template <uint8_t DEPTH>
+static bool checkSensorDebounce() {
+    static const uint8_t LENGTH = CHAIN_SENSOR_BUFFER_LENGTH(BENCH_MAX_MODULES);
+    static const uint32_t FRAMES = 20000;
+
+    SensorDebounce<LENGTH, DEPTH, 6> debounce;
+    uint8_t steady[LENGTH] = {};
+    uint8_t expected[LENGTH] = {};
+    uint8_t counts[LENGTH][8] = {};
+    uint8_t frame[LENGTH] = {};
+    unsigned int seed = DEPTH;
+
+    // The filter takes its first frame as the starting level
+    debounce.Filter(frame);
+
+    for (uint32_t n = 0; n < FRAMES; n++) {
+        for (uint8_t i = 0; i < LENGTH; i++) {
+            if (rand_r(&seed) % 64 == 0) {
+                steady[i] ^= 1 << (rand_r(&seed) % 8);
+            }
+            frame[i] = steady[i];
+            if (rand_r(&seed) % 4 == 0) {
+                frame[i] ^= 1 << (rand_r(&seed) % 8);
+            }
+        }
+
+        for (uint8_t i = 0; i < LENGTH; i++) {
+            for (uint8_t b = 0; b < 6; b++) {
+                uint8_t mask = 1 << b;
+                if ((frame[i] & mask) == (expected[i] & mask)) {
+                    counts[i][b] = 0;
+                } else if (++counts[i][b] == DEPTH) {
+                    expected[i] ^= mask;
+                    counts[i][b] = 0;
+                }
+            }
+            expected[i] = (expected[i] & 0x3F) | (frame[i] & 0xC0);
+        }
+
+        debounce.Filter(frame);
+        if (memcmp(frame, expected, LENGTH) != 0) {
+            printf("Sensor debounce check FAILED (depth %u): frame %u doesn't match\n", DEPTH, n);
+            return false;
+        }
+    }
+
+    BenchClock::time_point start = BenchClock::now();
+    for (uint32_t n = 0; n < FRAMES; n++) {
+        frame[n % LENGTH] ^= 1 << (n % 8);
+        debounce.Filter(frame);
+    }
+    uint64_t filter_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start).count();
+
+    printf("Sensor debounce: depth %u matches per-input counters over %u frames, %.1f ns/frame for %u modules\n",
+        DEPTH, FRAMES, (double)filter_ns / FRAMES, BENCH_MAX_MODULES);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    static const uint8_t DEFAULT_MODULE_COUNTS[] = {6, 12, 36, 72, 108, 144, 180, 216, 255};
+
+    uint8_t module_counts[BENCH_MAX_MODULES];
+    uint8_t num_counts = 0;
+    if (argc > 1) {
+        for (int i = 1; i < argc && num_counts < BENCH_MAX_MODULES; i++) {
+            int num_modules = atoi(argv[i]);
+            if (num_modules < 1 || num_modules > BENCH_MAX_MODULES) {
+                fprintf(stderr, "Module count must be between 1 and %d\n", BENCH_MAX_MODULES);
+                return 1;
+            }
+            module_counts[num_counts++] = num_modules;
+        }
+    } else {
+        memcpy(module_counts, DEFAULT_MODULE_COUNTS, sizeof(DEFAULT_MODULE_COUNTS));
+        num_counts = sizeof(DEFAULT_MODULE_COUNTS);
+    }
+
+    for (uint8_t i = 0; i < num_counts; i++) {
+        if (!crossCheck(module_counts[i]) || !crossCheckActiveSet(module_counts[i])) {
+            return 1;
+        }
+    }
+    if (!checkIoLayout()
+            || !checkSensorDebounce<1>()
+            || !checkSensorDebounce<2>()
+            || !checkSensorDebounce<3>()
+            || !checkSensorDebounce<4>()
+            || !checkSensorDebounce<8>()
+            || !checkSensorDebounce<16>()
+            || !checkFlapBoundaries<GEAR_RATIO_INPUT_STEPS, GEAR_RATIO_OUTPUT_FLAPS, NUM_FLAPS>()
+            || !checkFlapBoundaries<4076, 80, 40>()
+            || !checkFlapBoundaries<3200, 120, 40>()
+            || !checkFlapBoundaries<102400, 40, 40>()
+            || !checkWarmResume(module_engine)
+            || !checkWarmResume(batch_engine)) {
+        return 1;
+    }
+#if SPEED_CALIBRATION
+    if (!checkSpeedCap(module_engine) || !checkSpeedCap(batch_engine)) {
+        return 1;
+    }
+#endif
+    printf("Cross-check: SplitflapBatch and ActiveModuleSet match SplitflapModule for %u chain lengths over %u ticks each\n",
+        num_counts, CROSS_CHECK_TICKS);
+#if FRAME_CLOCK
+    if (!verifyFrameTiming()) {
+        return 1;
+    }
+#endif
+    printf("\n");
+
+    const Acceleration::MotionProfile& profile = Acceleration::MOTION_PROFILES[Acceleration::MOTION_PROFILE_NORMAL];
+#if FRAME_CLOCK
+    uint16_t min_period = ACCEL_STEP_PERIOD(profile, profile.max_accel_step) * Acceleration::FRAME_PERIOD_MICROS;
+#else
+    uint16_t min_period = ACCEL_STEP_PERIOD(profile, profile.max_accel_step);
+#endif
+    printf("Simulated tick: %u us, minimum step period: %u us\n\n", SIM_TICK_MICROS, min_period);
+    printf("%-7s %-6s %7s %10s %14s %14s %12s\n", "engine", "phase", "modules", "ticks", "ns/module/tick", "chain ticks/s", "worst (us)");
+
+    for (uint8_t i = 0; i < num_counts; i++) {
+        runBenchmark(module_engine, module_counts[i]);
+        runBenchmark(batch_engine, module_counts[i]);
+        runBenchmark(active_engine, module_counts[i]);
+        printf("\n");
+    }
+    return 0;
+}
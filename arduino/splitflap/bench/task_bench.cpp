@@ -0,0 +1,309 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+// Host-native load test of the whole SplitflapTask loop.
+//
+// Runs esp32/core/splitflap_task.cpp unchanged on the VIRTUAL_IO backend (a simulated chain, see
+// Splitflap/src/virtual_board.h) with the FreeRTOS and ESP32 stand-ins in bench/host/esp32. Boots the task (including
+// the chainlink loopback test and LED sweep), then sends it a series of random messages across the whole display and
+// waits for every module to come to rest on its flap, so homing, queueing, start admission, the loopback checks and
+// the state cache are all exercised as on the device. For each message it reports the simulated time taken and the
+// host CPU time of each pass of the task's loop (module updates plus the simulated motor_sensor_io()).
+//
+// Run with PlatformIO:
+//     pio run -e native-task-bench -t exec
+// or build directly:
+//     g++ -O2 -std=gnu++11 -Ibench/host/esp32 -Ibench/host -ISplitflap -Iesp32/core -DSPLITFLAP_PIO_HARDWARE_CONFIG
+//         -DREVERSE_MOTOR_DIRECTION=false -DCHAINLINK -DNUM_MODULES=255 -DVIRTUAL_IO=true
+//         bench/task_bench.cpp esp32/core/splitflap_task.cpp -o task_bench
+//
+// Other feature flags (e.g. -DBATCH_STEPPING=true, -DLAZY_HOMING=true, -DFRAME_CLOCK=true) can be added the same way.
+// The program exits with an error if a message isn't shown within TASK_BENCH_TIMEOUT_MICROS of simulated time, or if
+// the task reports a loopback failure.
+//
+// With -DLAZY_HOMING=true -DWARM_BOOT_RESUME=true, the messages are followed by a reset of every other module and,
+// once the display has come to rest, a warm restart of the task (on a fresh SplitflapTask, with the virtual spools
+// left where they are). Every module resting on a flap must resume on it, and every reset module still waiting to
+// home must still be waiting rather than resume as if homed; then one more message is shown. Add
+// -DLAZY_HOMING_BACKGROUND_MODULES=0 to leave the reset modules unhomed until the restart.
+
+#include <Arduino.h>
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include <esp_system.h>
+
+#include "splitflap_task.h"
+
+HostSerial Serial;
+
+#if !VIRTUAL_IO
+#error "The task bench needs the VIRTUAL_IO backend (-DVIRTUAL_IO=true)"
+#endif
+
+#define TASK_BENCH_MESSAGES 5
+#define TASK_BENCH_TIMEOUT_MICROS (60UL * 1000 * 1000)
+
+typedef std::chrono::steady_clock BenchClock;
+
+class PrintLogger : public Logger {
+    public:
+        void log(const char* msg) override {
+            printf("  [task] %s\n", msg);
+        }
+};
+
+static SplitflapTask* splitflap_task;
+static PrintLogger logger;
+
+static uint8_t message_count = 0;
+static uint8_t target_flaps[NUM_MODULES];
+static unsigned long message_start_micros;
+static uint32_t message_passes;
+static uint64_t message_total_ns;
+static uint64_t message_worst_ns;
+static BenchClock::time_point pass_start;
+
+#if LAZY_HOMING && WARM_BOOT_RESUME
+// Thrown by onPass() to stop the running task, so that main() can boot a new one as after a warm reset
+struct TaskRestart {};
+
+enum class RestartPhase {
+    NONE,
+    RESETTING,  // Waiting for the display to come to rest after the reset
+    RESTARTED,  // Waiting for the first pass of the restarted task
+    DONE,
+};
+
+// The display has to stay at rest this long before the restart, so that background homing has had every chance to
+// start (and the task to save its resume state)
+#define TASK_BENCH_REST_MICROS (1000UL * 1000)
+
+static RestartPhase restart_phase = RestartPhase::NONE;
+static SplitflapModuleState rest_modules[NUM_MODULES];
+static unsigned long rest_start_micros;
+#endif
+
+// Picks a new flap for every module (never the blank home flap, and never the one it's already showing, so every
+// module has to move) and sends the message to the task
+static void sendMessage() {
+    char message[NUM_MODULES];
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        uint8_t flap;
+        do {
+            flap = 1 + rand() % (NUM_FLAPS - 1);
+        } while (flap == target_flaps[i]);
+        target_flaps[i] = flap;
+        message[i] = flaps[flap];
+    }
+    splitflap_task->showString(message, NUM_MODULES);
+
+    message_start_micros = micros();
+    message_passes = 0;
+    message_total_ns = 0;
+    message_worst_ns = 0;
+}
+
+static bool messageShown(const SplitflapState& state) {
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        const SplitflapModuleState& module = state.modules[i];
+        if (module.state != NORMAL || module.moving || module.flap_index != target_flaps[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if LAZY_HOMING && WARM_BOOT_RESUME
+// Resets every other module (with LAZY_HOMING, deferring its homing)
+static void resetAlternateModules() {
+    Command command = {};
+    command.command_type = CommandType::MODULES;
+    for (uint8_t i = 0; i < NUM_MODULES; i += 2) {
+        command.data.module_command[i] = QCMD_RESET_AND_HOME;
+    }
+    splitflap_task->postRawCommand(command);
+
+    restart_phase = RestartPhase::RESETTING;
+    message_start_micros = micros();
+    rest_start_micros = micros();
+}
+
+// Restarts the task once no module has moved for TASK_BENCH_REST_MICROS
+static void waitToRestart(const SplitflapState& state) {
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        if (state.modules[i].moving) {
+            rest_start_micros = micros();
+            break;
+        }
+    }
+    if (micros() - rest_start_micros >= TASK_BENCH_REST_MICROS) {
+        memcpy(rest_modules, state.modules, sizeof(rest_modules));
+        restart_phase = RestartPhase::RESTARTED;
+        throw TaskRestart();
+    }
+    if (micros() - message_start_micros > TASK_BENCH_TIMEOUT_MICROS) {
+        printf("Task bench FAILED: display not at rest %lu s after the reset (simulated)\n", TASK_BENCH_TIMEOUT_MICROS / 1000000);
+        exit(1);
+    }
+}
+
+// Checks the state of the restarted task after its first pass against the state before the restart
+static void checkResumed(const SplitflapState& state) {
+    uint8_t resumed = 0;
+    uint8_t unhomed = 0;
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        const SplitflapModuleState& before = rest_modules[i];
+        const SplitflapModuleState& after = state.modules[i];
+        if (before.state == NORMAL) {
+            if (after.state != NORMAL || after.flap_index != before.flap_index) {
+                printf("Task bench FAILED: module %u resting on flap %u before the restart came back in state %u on flap %u\n",
+                    i, before.flap_index, after.state, after.flap_index);
+                exit(1);
+            }
+            resumed++;
+        } else if (before.state == LOOK_FOR_HOME) {
+            if (after.state == NORMAL) {
+                printf("Task bench FAILED: unhomed module %u resumed on flap %u after the restart\n", i, after.flap_index);
+                exit(1);
+            }
+            unhomed++;
+        }
+    }
+    printf("\nWarm restart: %u modules resumed, %u still to home\n\n", resumed, unhomed);
+    restart_phase = RestartPhase::DONE;
+}
+#endif
+
+// Called at the end of each pass of the task's loop (and wherever boot resets the watchdog)
+static void onPass() {
+    uint64_t pass_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - pass_start).count();
+
+    if (message_count == 0) {
+        printf("Booted in %.1f s (simulated)\n\n", micros() / 1e6);
+        printf("%-8s %7s %12s %10s %14s %12s\n", "message", "modules", "simulated s", "passes", "ns/pass", "worst (us)");
+        message_count++;
+        sendMessage();
+        pass_start = BenchClock::now();
+        return;
+    }
+
+    message_passes++;
+    message_total_ns += pass_ns;
+    if (pass_ns > message_worst_ns) {
+        message_worst_ns = pass_ns;
+    }
+
+    SplitflapState state = splitflap_task->getState();
+#if LAZY_HOMING && WARM_BOOT_RESUME
+    if (restart_phase == RestartPhase::RESETTING) {
+        waitToRestart(state);
+        pass_start = BenchClock::now();
+        return;
+    }
+    if (restart_phase == RestartPhase::RESTARTED) {
+#if SPI_CLOCK_CALIBRATION
+        if (state.spi_clock_hz == 0) {
+            // Still calibrating the SPI clock, so the task hasn't reported any state yet
+            pass_start = BenchClock::now();
+            return;
+        }
+#endif
+        checkResumed(state);
+        message_count++;
+        sendMessage();
+        pass_start = BenchClock::now();
+        return;
+    }
+#endif
+#ifdef CHAINLINK
+    // The task's own loopback check takes 50 passes per loopback to get round them all; allow for the passes counted
+    // during boot too
+    if (!state.loopbacks_ok && message_passes > 2 * 50 * NUM_LOOPBACKS) {
+        printf("Task bench FAILED: loopback check failed\n");
+        exit(1);
+    }
+#endif
+    if (messageShown(state)) {
+        printf("%-8u %7u %12.2f %10u %14.0f %12.1f\n", message_count, NUM_MODULES,
+            (micros() - message_start_micros) / 1e6, message_passes,
+            (double)message_total_ns / message_passes, message_worst_ns / 1e3);
+        if (message_count >= TASK_BENCH_MESSAGES) {
+#if LAZY_HOMING && WARM_BOOT_RESUME
+            if (restart_phase == RestartPhase::NONE) {
+                resetAlternateModules();
+                pass_start = BenchClock::now();
+                return;
+            }
+#endif
+#if SPI_CLOCK_CALIBRATION
+            // The virtual chain reads back cleanly up to VIRTUAL_IO_MAX_CLOCK_HZ
+            uint32_t max_clock_hz = std::min(VIRTUAL_IO_MAX_CLOCK_HZ, SPI_CLOCK_CALIBRATION_MAX_HZ);
+            uint32_t clean_clock_hz = SPI_CLOCK_CALIBRATION_MIN_HZ
+                + (max_clock_hz - SPI_CLOCK_CALIBRATION_MIN_HZ) / SPI_CLOCK_CALIBRATION_STEP_HZ * SPI_CLOCK_CALIBRATION_STEP_HZ;
+            uint32_t expected_clock_hz = clean_clock_hz / 100 * (100 - SPI_CLOCK_CALIBRATION_MARGIN_PERCENT);
+            if (state.spi_clock_hz != expected_clock_hz) {
+                printf("Task bench FAILED: SPI clock calibrated to %u Hz, expected %u Hz\n", state.spi_clock_hz, expected_clock_hz);
+                exit(1);
+            }
+            printf("\nSPI clock calibrated to %u Hz\n", state.spi_clock_hz);
+#endif
+            printf("\nTask bench: %u messages shown on %u modules\n", message_count, NUM_MODULES);
+            fflush(stdout);
+            exit(0);
+        }
+        message_count++;
+        sendMessage();
+    } else if (micros() - message_start_micros > TASK_BENCH_TIMEOUT_MICROS) {
+        printf("Task bench FAILED: message %u not shown after %lu s (simulated)\n", message_count, TASK_BENCH_TIMEOUT_MICROS / 1000000);
+        for (uint8_t i = 0; i < NUM_MODULES; i++) {
+            const SplitflapModuleState& module = state.modules[i];
+            if (module.state != NORMAL || module.moving || module.flap_index != target_flaps[i]) {
+                printf("  module %u: state %u, flap %u (target %u)%s\n", i, module.state, module.flap_index,
+                    target_flaps[i], module.moving ? ", moving" : "");
+            }
+        }
+        exit(1);
+    }
+
+    pass_start = BenchClock::now();
+}
+
+// Runs a new task on this thread; it never returns, and onPass() exits once all messages have been shown
+static void bootTask() {
+    splitflap_task = new SplitflapTask(0, LedMode::AUTO);
+    splitflap_task->setLogger(&logger);
+    splitflap_task->begin();
+}
+
+int main(int argc, char** argv) {
+    srand(1);
+    HostTask::pass_hook() = &onPass;
+
+#if LAZY_HOMING && WARM_BOOT_RESUME
+    try {
+        bootTask();
+    } catch (const TaskRestart&) {
+        // The old task is abandoned rather than deleted: a reset runs no destructors
+    }
+    host_reset_reason() = ESP_RST_SW;
+#endif
+    bootTask();
+    return 1;
+}
@@ -21,12 +21,7 @@
 #define PIN_DOWN_BUTTON         0
 
 
-/**
- * MODIFY THIS to configure which modules are connected to which power channels!
- */
-uint8_t BaseSupervisorTask::getPowerChannelForModuleIndex(uint8_t module_index) {
-    return module_index / 36;
-}
+static_assert(NUM_MODULE_POWER_CHANNELS <= NUM_POWER_CHANNELS, "getPowerChannelForModuleIndex() maps modules to more power channels than the base has");
 
 /** Maps power channel index (0-4) to MCP GPIO pin. */
 static const uint8_t MCP_PIN_CHANNEL_EN[NUM_POWER_CHANNELS] = {
@@ -22,6 +22,7 @@
 #include "src/Adafruit_INA219.h"
 
 #include "../splitflap/serial_task.h"
+#include "../core/power_channels.h"
 #include "../core/splitflap_task.h"
 #include "../core/task.h"
 
@@ -37,7 +38,6 @@ class BaseSupervisorTask : public Task<BaseSupervisorTask> {
         void run();
 
     private:
-        static uint8_t getPowerChannelForModuleIndex(uint8_t module_index);
 
         SplitflapTask& splitflap_task_;
         SerialTask& serial_task_;
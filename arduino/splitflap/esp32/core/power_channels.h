@@ -0,0 +1,41 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+#include "config.h"
+
+/**
+ * MODIFY THIS to configure which modules are connected to which power channels!
+ *
+ * Used both by the base supervisor (expected current per channel) and by SplitflapTask (limiting how many motors
+ * start at once on each channel).
+ */
+constexpr uint8_t getPowerChannelForModuleIndex(uint8_t module_index) {
+    return module_index / 36;
+}
+
+// Highest power channel used by modules 0..num_modules-1 (channel_so_far being the highest one among modules >= num_modules)
+constexpr uint8_t maxPowerChannelForModules(uint8_t num_modules, uint8_t channel_so_far = 0) {
+    return num_modules == 0
+        ? channel_so_far
+        : maxPowerChannelForModules(num_modules - 1,
+            getPowerChannelForModuleIndex(num_modules - 1) > channel_so_far ? getPowerChannelForModuleIndex(num_modules - 1) : channel_so_far);
+}
+
+// Number of power channels used by modules 0..NUM_MODULES-1
+#define NUM_MODULE_POWER_CHANNELS (maxPowerChannelForModules(NUM_MODULES) + 1)
@@ -15,11 +15,20 @@
 */
 
 #include <esp_task_wdt.h>
+#if WARM_BOOT_RESUME
+#include <esp_system.h>
+#include <rom/crc.h>
+#include <stddef.h>
+#endif
 
 // General splitflap includes
 #include "config.h"
 #include "src/splitflap_module.h"
+#if VIRTUAL_IO
+#include "src/virtual_io_config.h"
+#else
 #include "src/spi_io_config.h"
+#endif
 
 // ESP32-specific includes
 #include "semaphore_guard.h"
@@ -28,6 +37,74 @@
 
 static_assert(QCMD_FLAP + NUM_FLAPS <= 255, "Too many flaps to fit in uint8_t command structure");
 
+#if SPI_IO_SPLIT_CHAIN && defined(CHAINLINK_BASE)
+#include "../base/base_config.h"
+
+static constexpr bool isBaseBoardPin(int pin) {
+    return pin == BASE_NEOPIXEL_PIN || pin == BASE_MCP_NRESET_PIN || pin == BASE_MASTER_EN_PIN;
+}
+static_assert(!isBaseBoardPin(LATCH_PIN_2) && !isBaseBoardPin(PIN_NUM_MISO_2) && !isBaseBoardPin(PIN_NUM_MOSI_2)
+        && !isBaseBoardPin(PIN_NUM_CLK_2), "SPI_IO_SPLIT_CHAIN pins clash with the base board (see base/base_config.h)");
+#endif
+
+#if (HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS) || SPEED_CALIBRATION
+#define SPLITFLAP_NVS_NAMESPACE "splitflap"
+#endif
+
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+#define HOME_CALIBRATION_NVS_KEY "home_cal"
+#define HOME_CALIBRATION_SAVE_INTERVAL_MILLIS (10 * 60 * 1000)
+#endif
+
+#if SPEED_CALIBRATION
+#define SPEED_CALIBRATION_NVS_KEY "speed_cal"
+#endif
+
+#if WARM_BOOT_RESUME
+#define RESUME_STATE_MAGIC 0x53464c50
+#define RESUME_STEP_NONE UINT32_MAX
+
+// Everything needed to pick up where the previous boot left off: each module's resting position (step
+// RESUME_STEP_NONE if it wasn't at rest) and the last config received, so that the host resending the same config
+// after reconnecting isn't taken as a new movement or reset. Kept in RTC slow memory, which isn't cleared by a
+// warm reset.
+struct ResumeState {
+    uint32_t magic;
+    uint32_t gear_ratio_input_steps;
+    ModulePosition positions[NUM_MODULES];
+    ModuleConfigs configs;
+    uint32_t crc;
+};
+
+RTC_NOINIT_ATTR static ResumeState resume_state;
+
+static uint32_t resumeStateCrc() {
+    return crc32_le(0, (const uint8_t*)&resume_state, offsetof(ResumeState, crc));
+}
+#endif
+
+// Sensor inputs as of the previous pass of runUpdate, used to wake idle modules when their home sensor changes
+static uint8_t last_sensor_buffer[SENSOR_BUFFER_LENGTH];
+
+#if FRAME_CLOCK
+// Hardware timer that paces runUpdate() at one pass per frame. The ISR just counts frames and wakes the task; the
+// frame count is the time base passed to the modules' Update().
+#define FRAME_TIMER_NUM 0
+
+static hw_timer_t* frame_timer = nullptr;
+static TaskHandle_t frame_task = nullptr;
+static volatile uint32_t frame_count = 0;
+
+static void IRAM_ATTR onFrameTimer() {
+    frame_count++;
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(frame_task, &higher_priority_task_woken);
+    if (higher_priority_task_woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+#endif
+
 SplitflapTask::SplitflapTask(const uint8_t task_core, const LedMode led_mode) : Task("Splitflap", 2048, 1, task_core), led_mode_(led_mode), state_semaphore_(xSemaphoreCreateMutex()) {
   assert(state_semaphore_ != NULL);
   xSemaphoreGive(state_semaphore_);
@@ -52,8 +129,13 @@ void SplitflapTask::run() {
 
     initialize_modules();
 
+#if WARM_BOOT_RESUME
+    bool resume = loadResumeState();
+#endif
+
     // Initialize shift registers before turning on shift register output-enable
     motor_sensor_io();
+    motor_sensor_io_wait();
 
 #ifdef OUTPUT_ENABLE_PIN
     pinMode(OUTPUT_ENABLE_PIN, OUTPUT);
@@ -61,6 +143,10 @@ void SplitflapTask::run() {
 #endif
 
 #if (defined(CHAINLINK) && !defined(CHAINLINK_DRIVER_TESTER))
+#if SPI_CLOCK_CALIBRATION
+    calibrateSpiClock();
+#endif
+
 #if CHAINLINK_ENFORCE_LOOPBACKS
     bool loopback_result[NUM_LOOPBACKS][NUM_LOOPBACKS];
     bool loopback_off_result[NUM_LOOPBACKS];
@@ -90,7 +176,12 @@ void SplitflapTask::run() {
     loopback_all_ok_ = true;
 #endif
 
-    if (led_mode_ == LedMode::AUTO) {
+    // Skipped on a warm boot to get back to showing messages as soon as possible
+    if (led_mode_ == LedMode::AUTO
+#if WARM_BOOT_RESUME
+            && !resume
+#endif
+    ) {
         for (uint8_t i = 0; i < NUM_MODULES; i++) {
             chainlink_set_led(i, 1);
             motor_sensor_io();
@@ -103,16 +194,69 @@ void SplitflapTask::run() {
     }
 #endif
 
+#if (HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS) || SPEED_CALIBRATION
+    preferences_.begin(SPLITFLAP_NVS_NAMESPACE);
+#endif
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+    loadHomeCalibration();
+#endif
+#if SPEED_CALIBRATION
+    loadSpeedCalibration();
+#endif
+
     for (uint8_t i = 0; i < NUM_MODULES; i++) {
         modules[i]->Init();
+#if WARM_BOOT_RESUME
+        if (resume && resume_state.positions[i].step != RESUME_STEP_NONE && modules[i]->ResumeAt(resume_state.positions[i])) {
+            continue;
+        }
+#endif
 #if !defined(CHAINLINK_DRIVER_TESTER) && !defined(CHAINLINK_BASE)
+#if LAZY_HOMING
+        deferHoming(i);
+#else
         modules[i]->GoHome();
+#endif
 #endif
     }
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        startModule(i);
+    }
+    memcpy(last_sensor_buffer, sensor_buffer, SENSOR_BUFFER_LENGTH);
+
+#if FRAME_CLOCK
+    frame_task = xTaskGetCurrentTaskHandle();
+    frame_timer = timerBegin(FRAME_TIMER_NUM, 80, true); // 80MHz APB clock / 80 = 1 tick per microsecond
+    timerAttachInterrupt(frame_timer, &onFrameTimer, true);
+    timerAlarmWrite(frame_timer, Acceleration::FRAME_PERIOD_MICROS, true);
+    timerAlarmEnable(frame_timer);
+#endif
 
     while(1) {
         processQueue();
         runUpdate();
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+        if (all_stopped_) {
+            saveHomeCalibration();
+        }
+#endif
+#if SPEED_CALIBRATION
+        if (all_stopped_ && speed_calibration_changed_) {
+            saveSpeedCalibration();
+        }
+#endif
+#if STEP_TIMING_STATS
+        if (millis() - last_step_timing_millis_ >= STEP_TIMING_STATS_INTERVAL_MILLIS) {
+            collectStepTimingStats();
+        }
+#endif
+#if WARM_BOOT_RESUME
+        if (all_stopped_ && !resume_state_saved_) {
+            saveResumeState();
+        } else if (!all_stopped_ && resume_state_saved_) {
+            invalidateResumeState();
+        }
+#endif
         result = esp_task_wdt_reset();
         ESP_ERROR_CHECK(result);
     }
@@ -120,6 +264,11 @@ void SplitflapTask::run() {
 
 void SplitflapTask::processQueue() {
     if (xQueueReceive(queue_, &queue_receive_buffer_, 0) == pdTRUE) {
+#if WARM_BOOT_RESUME
+        if (resume_state_saved_) {
+            invalidateResumeState();
+        }
+#endif
         switch (queue_receive_buffer_.command_type) {
             case CommandType::MODULES: {
                 uint8_t* data = queue_receive_buffer_.data.module_command;
@@ -130,8 +279,17 @@ void SplitflapTask::processQueue() {
                             // No-op
                             break;
                         case QCMD_RESET_AND_HOME:
+                            clearQueuedTargets(i);
+#if SPEED_CALIBRATION
+                            cancelSpeedCalibration(i);
+#endif
                             modules[i]->ResetState();
+#if LAZY_HOMING
+                            deferHoming(i);
+#else
                             modules[i]->GoHome();
+#endif
+                            startModule(i);
                             break;
                         case QCMD_LED_ON:
                             any_leds = true;
@@ -146,11 +304,26 @@ void SplitflapTask::processQueue() {
     #endif
                             break;
                         case QCMD_DISABLE:
+                            clearQueuedTargets(i);
+#if SPEED_CALIBRATION
+                            cancelSpeedCalibration(i);
+#endif
+#if LAZY_HOMING
+                            cancelDeferredHoming(i);
+#endif
                             modules[i]->Disable();
                             break;
                         default:
                             assert(data[i] >= QCMD_FLAP && data[i] < QCMD_FLAP + NUM_FLAPS);
+                            clearQueuedTargets(i);
+#if SPEED_CALIBRATION
+                            cancelSpeedCalibration(i);
+#endif
+#if LAZY_HOMING
+                            homeIfDeferred(i);
+#endif
                             modules[i]->GoToFlapIndex(data[i] - QCMD_FLAP);
+                            startModule(i);
                             break;
                     }
                 }
@@ -170,9 +343,41 @@ void SplitflapTask::processQueue() {
                 for (uint8_t i = 0; i < NUM_MODULES; i++) {
                     ModuleConfig config = configs.config[i];
 
+#if SPEED_CALIBRATION
+                    if (calibrating_modules_.Contains(i)) {
+                        if (config.reset_nonce == current_configs_.config[i].reset_nonce
+                                && config.target_flap_index == current_configs_.config[i].target_flap_index
+                                && config.movement_nonce == current_configs_.config[i].movement_nonce) {
+                            // Nothing new for this module; leave it to finish calibrating, then switch to the profile
+                            // asked for here
+                            if (config.motion_profile < Acceleration::NUM_MOTION_PROFILES) {
+                                speed_calibration_[i].motion_profile = config.motion_profile;
+                            }
+                            continue;
+                        }
+                        cancelSpeedCalibration(i);
+                    }
+#endif
+
+                    // Applied before any movement below so that a move issued in the same config uses the new profile
+                    if (config.motion_profile != modules[i]->GetMotionProfile()) {
+                        if (config.motion_profile >= Acceleration::NUM_MOTION_PROFILES) {
+                            char buffer[200] = {};
+                            snprintf(buffer, sizeof(buffer), "Invalid motion profile (%u) specified for module %u", config.motion_profile, i);
+                            log(buffer);
+                        } else {
+                            modules[i]->SetMotionProfile(config.motion_profile);
+                        }
+                    }
+
                     if (config.reset_nonce != current_configs_.config[i].reset_nonce) {
+                        clearQueuedTargets(i);
                         modules[i]->ResetErrorCounters();
+#if LAZY_HOMING
+                        cancelDeferredHoming(i);
+#endif
                         modules[i]->GoHome();
+                        startModule(i);
                     }
 
                     if (config.target_flap_index != current_configs_.config[i].target_flap_index ||
@@ -183,19 +388,370 @@ void SplitflapTask::processQueue() {
                             snprintf(buffer, sizeof(buffer), "Invalid flap index (%u) specified for module %u", config.target_flap_index, i);
                             log(buffer);
                         } else {
+                            clearQueuedTargets(i);
+#if LAZY_HOMING
+                            homeIfDeferred(i);
+#endif
                             modules[i]->GoToFlapIndex(config.target_flap_index);
+                            startModule(i);
                         }
                     }
                 }
                 current_configs_ = configs;
                 break;
             }
+            case CommandType::QUEUE_TARGETS: {
+                QueuedTarget* targets = queue_receive_buffer_.data.queued_targets;
+                for (uint8_t i = 0; i < NUM_MODULES; i++) {
+                    if (targets[i].flap_index == QUEUED_TARGET_NONE) {
+                        continue;
+                    }
+                    char buffer[200] = {};
+                    if (targets[i].flap_index >= NUM_FLAPS) {
+                        snprintf(buffer, sizeof(buffer), "Invalid flap index (%u) queued for module %u", targets[i].flap_index, i);
+                        log(buffer);
+                    } else if (!target_queues_.Push(i, targets[i].flap_index, targets[i].dwell_millis)) {
+                        snprintf(buffer, sizeof(buffer), "Target queue full for module %u; dropped flap index %u", i, targets[i].flap_index);
+                        log(buffer);
+                    } else {
+#if LAZY_HOMING
+                        homeIfDeferred(i);
+#endif
+#if SPEED_CALIBRATION
+                        cancelSpeedCalibration(i);
+#endif
+                        queued_modules_.Add(i);
+                    }
+                }
+                break;
+            }
+            case CommandType::CALIBRATE_SPEED: {
+#if SPEED_CALIBRATION
+                uint8_t* data = queue_receive_buffer_.data.module_command;
+                for (uint8_t i = 0; i < NUM_MODULES; i++) {
+                    if (data[i]) {
+                        startSpeedCalibration(i);
+                    }
+                }
+#else
+                log("Speed calibration is not enabled in this build");
+#endif
+                break;
+            }
+        }
+    }
+}
+
+// Adds module i to the update loop after it has been sent a command. With MAX_MODULE_STARTS_PER_POWER_CHANNEL, a module
+// that the command takes from a stop into motion has to be admitted first.
+void SplitflapTask::startModule(uint8_t i) {
+#if MAX_MODULE_STARTS_PER_POWER_CHANNEL
+    if (modules[i]->current_accel_step == 0 && !modules[i]->IsIdle() && !starting_modules_.Contains(i)) {
+        if (starting_count_[getPowerChannelForModuleIndex(i)] < MAX_MODULE_STARTS_PER_POWER_CHANNEL) {
+            admitModule(i);
+        } else {
+            pending_starts_.Add(i);
+        }
+        return;
+    }
+#endif
+    active_modules_.Add(i);
+}
+
+// Drops any queued targets when a module is sent an immediate command
+void SplitflapTask::clearQueuedTargets(uint8_t i) {
+    target_queues_.Clear(i);
+    dwell_millis_[i] = 0;
+}
+
+void SplitflapTask::updateQueuedTargets() {
+    uint32_t now = millis();
+    for (int16_t n = queued_modules_.Size() - 1; n >= 0; n--) {
+        uint8_t i = queued_modules_[n];
+        if (!modules[i]->IsIdle()) {
+            // Dwell time counts from when the module comes to rest
+            dwell_start_millis_[i] = now;
+            continue;
+        }
+        if (modules[i]->state != NORMAL) {
+            // Error, disabled, or gave up homing; drop the rest of the sequence
+            clearQueuedTargets(i);
+            queued_modules_.RemoveAt(n);
+            continue;
+        }
+        if (now - dwell_start_millis_[i] < dwell_millis_[i]) {
+            continue;
+        }
+
+        uint8_t flap_index;
+        if (!target_queues_.Pop(i, &flap_index, &dwell_millis_[i])) {
+            queued_modules_.RemoveAt(n);
+            continue;
+        }
+        modules[i]->GoToFlapIndex(flap_index);
+        dwell_start_millis_[i] = now;
+        startModule(i);
+    }
+}
+
+#if LAZY_HOMING
+// Leaves module i unhomed (and, once stopped, unpowered) until it's first sent a flap or the background pass homes it
+void SplitflapTask::deferHoming(uint8_t i) {
+    if (!homing_deferred_[i]) {
+        homing_deferred_[i] = true;
+        deferred_count_++;
+    }
+}
+
+// Returns whether homing of module i was deferred
+bool SplitflapTask::cancelDeferredHoming(uint8_t i) {
+    if (!homing_deferred_[i]) {
+        return false;
+    }
+    homing_deferred_[i] = false;
+    deferred_count_--;
+    return true;
+}
+
+// Homes module i now if its homing was deferred, so that a flap sent to it is shown once home is found
+void SplitflapTask::homeIfDeferred(uint8_t i) {
+    if (cancelDeferredHoming(i)) {
+        modules[i]->GoHome();
+        startModule(i);
+    }
+}
+
+void SplitflapTask::updateBackgroundHoming() {
+    for (int16_t n = background_homing_.Size() - 1; n >= 0; n--) {
+        if (modules[background_homing_[n]]->state != LOOK_FOR_HOME) {
+            background_homing_.RemoveAt(n);
+        }
+    }
+#if MAX_MODULE_STARTS_PER_POWER_CHANNEL
+    if (pending_starts_.Size() > 0) {
+        // Commanded moves get the free start slots first
+        return;
+    }
+#endif
+    while (deferred_count_ > 0 && background_homing_.Size() < LAZY_HOMING_BACKGROUND_MODULES) {
+        while (!homing_deferred_[background_homing_cursor_]) {
+            background_homing_cursor_ = (background_homing_cursor_ + 1) % NUM_MODULES;
+        }
+        uint8_t i = background_homing_cursor_;
+        homeIfDeferred(i);
+        background_homing_.Add(i);
+    }
+}
+#endif
+
+#if SPEED_CALIBRATION
+// Homes module i and then sweeps its speed cap from ACCEL_MIN_PERIOD_MICROS (the NORMAL profile's top speed) down to
+// ACCEL_CALIBRATION_MIN_PERIOD_MICROS on the FAST profile, running SPEED_CALIBRATION_REVOLUTIONS revolutions at each
+// period, until it has a home error or reaches the end of the sweep.
+void SplitflapTask::startSpeedCalibration(uint8_t i) {
+    if (calibrating_modules_.Contains(i)) {
+        return;
+    }
+    if (modules[i]->state == PANIC || modules[i]->state == STATE_DISABLED) {
+        char buffer[100] = {};
+        snprintf(buffer, sizeof(buffer), "Can't calibrate speed of disabled module %u", i);
+        log(buffer);
+        return;
+    }
+    clearQueuedTargets(i);
+#if LAZY_HOMING
+    cancelDeferredHoming(i);
+#endif
+
+    SpeedCalibrationRun& run = speed_calibration_[i];
+    run.min_period_micros = ACCEL_MIN_PERIOD_MICROS;
+    run.passed_min_period_micros = 0;
+    run.revolutions_left = SPEED_CALIBRATION_REVOLUTIONS;
+    run.count_missed_home = modules[i]->count_missed_home;
+    run.count_unexpected_home = modules[i]->count_unexpected_home;
+    run.motion_profile = modules[i]->GetMotionProfile();
+    run.target_flap_index = modules[i]->GetTargetFlapIndex();
+
+    modules[i]->SetMotionProfile(Acceleration::MOTION_PROFILE_FAST);
+    modules[i]->SetMinStepPeriod(run.min_period_micros);
+    modules[i]->GoHome();
+    startModule(i);
+    calibrating_modules_.Add(i);
+}
+
+// Ends module i's sweep without changing its speed cap, e.g. when the host sends it something else to do
+void SplitflapTask::cancelSpeedCalibration(uint8_t i) {
+    if (!calibrating_modules_.Contains(i)) {
+        return;
+    }
+    for (uint8_t n = 0; n < calibrating_modules_.Size(); n++) {
+        if (calibrating_modules_[n] == i) {
+            calibrating_modules_.RemoveAt(n);
+            break;
+        }
+    }
+    modules[i]->SetMinStepPeriod(min_step_period_micros_[i]);
+    modules[i]->SetMotionProfile(speed_calibration_[i].motion_profile);
+}
+
+// Ends module i's sweep, capping it SPEED_CALIBRATION_MARGIN_PERCENT slower than the shortest period it ran cleanly
+// at, and sends it back to the flap it was showing before
+void SplitflapTask::finishSpeedCalibration(uint8_t i) {
+    SpeedCalibrationRun& run = speed_calibration_[i];
+    // A module that isn't clean even at the first period gets the margin on top of that one
+    uint16_t clean_period = run.passed_min_period_micros != 0 ? run.passed_min_period_micros : run.min_period_micros;
+    min_step_period_micros_[i] = clean_period + (uint32_t)clean_period * SPEED_CALIBRATION_MARGIN_PERCENT / 100;
+    speed_calibration_changed_ = true;
+
+    char buffer[200] = {};
+    if (run.passed_min_period_micros != 0) {
+        snprintf(buffer, sizeof(buffer), "Module %u ran cleanly down to %u us per step; capped at %u us", i, clean_period, min_step_period_micros_[i]);
+    } else {
+        snprintf(buffer, sizeof(buffer), "Module %u had home errors even at %u us per step; capped at %u us", i, clean_period, min_step_period_micros_[i]);
+    }
+    log(buffer);
+
+    cancelSpeedCalibration(i);
+    modules[i]->GoToFlapIndex(run.target_flap_index);
+    startModule(i);
+}
+
+// Moves each module's sweep on whenever the module comes to rest: after homing, and after each revolution. Running one
+// flap short of a full revolution brings it to rest (and home errors to light) once per revolution.
+void SplitflapTask::updateSpeedCalibration() {
+    for (int16_t n = calibrating_modules_.Size() - 1; n >= 0; n--) {
+        uint8_t i = calibrating_modules_[n];
+        SpeedCalibrationRun& run = speed_calibration_[i];
+        if (modules[i]->count_missed_home != run.count_missed_home
+                || modules[i]->count_unexpected_home != run.count_unexpected_home) {
+            // Lost its position at run.min_period_micros, and is already homing again
+            finishSpeedCalibration(i);
+            continue;
+        }
+        if (!modules[i]->IsIdle()) {
+            continue;
+        }
+        if (modules[i]->state != NORMAL) {
+            char buffer[100] = {};
+            snprintf(buffer, sizeof(buffer), "Speed calibration of module %u aborted: module isn't homed", i);
+            log(buffer);
+            cancelSpeedCalibration(i);
+            continue;
+        }
+
+        if (run.revolutions_left == 0) {
+            run.passed_min_period_micros = run.min_period_micros;
+            if (run.min_period_micros < ACCEL_CALIBRATION_MIN_PERIOD_MICROS + ACCEL_CALIBRATION_PERIOD_STEP_MICROS) {
+                finishSpeedCalibration(i);
+                continue;
+            }
+            run.min_period_micros -= ACCEL_CALIBRATION_PERIOD_STEP_MICROS;
+            run.revolutions_left = SPEED_CALIBRATION_REVOLUTIONS;
+            modules[i]->SetMinStepPeriod(run.min_period_micros);
         }
+        run.revolutions_left--;
+        modules[i]->GoToFlapIndex((modules[i]->GetCurrentFlapIndex() + NUM_FLAPS - 1) % NUM_FLAPS);
+        startModule(i);
     }
 }
 
+void SplitflapTask::loadSpeedCalibration() {
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        min_step_period_micros_[i] = ACCEL_FAST_MIN_PERIOD_MICROS;
+    }
+    size_t length = preferences_.getBytesLength(SPEED_CALIBRATION_NVS_KEY);
+    if (length == 0) {
+        return;
+    }
+    if (length != sizeof(min_step_period_micros_)) {
+        char buffer[100] = {};
+        snprintf(buffer, sizeof(buffer), "Ignoring saved speed calibration of %u bytes (expected %u)", (unsigned)length, (unsigned)sizeof(min_step_period_micros_));
+        log(buffer);
+        return;
+    }
+    preferences_.getBytes(SPEED_CALIBRATION_NVS_KEY, min_step_period_micros_, sizeof(min_step_period_micros_));
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        modules[i]->SetMinStepPeriod(min_step_period_micros_[i]);
+    }
+    log("Loaded speed calibration");
+}
+
+void SplitflapTask::saveSpeedCalibration() {
+    preferences_.putBytes(SPEED_CALIBRATION_NVS_KEY, min_step_period_micros_, sizeof(min_step_period_micros_));
+    speed_calibration_changed_ = false;
+}
+#endif
+
+#if SPI_CLOCK_CALIBRATION
+// Raises the SPI clock from SPI_CLOCK_CALIBRATION_MIN_HZ until a round of loopback patterns reads back wrong, then
+// settles SPI_CLOCK_CALIBRATION_MARGIN_PERCENT below the fastest clock that was clean. Stays at the slowest clock if
+// even that fails (the loopback test that follows will then report the chain as broken).
+void SplitflapTask::calibrateSpiClock() {
+    uint32_t clean_clock_hz = 0;
+    for (uint32_t clock_hz = SPI_CLOCK_CALIBRATION_MIN_HZ; clock_hz <= SPI_CLOCK_CALIBRATION_MAX_HZ;
+            clock_hz += SPI_CLOCK_CALIBRATION_STEP_HZ) {
+        motor_sensor_io_set_clock(clock_hz);
+        uint16_t errors = chainlink_test_loopback_patterns(SPI_CLOCK_CALIBRATION_FRAMES, clock_hz);
+        esp_err_t result = esp_task_wdt_reset();
+        ESP_ERROR_CHECK(result);
+        if (errors > 0) {
+            break;
+        }
+        clean_clock_hz = clock_hz;
+    }
+
+    char buffer[100];
+    if (clean_clock_hz == 0) {
+        spi_clock_hz_ = SPI_CLOCK_CALIBRATION_MIN_HZ;
+        snprintf(buffer, sizeof(buffer), "SPI clock calibration failed, using %u Hz", spi_clock_hz_);
+    } else {
+        spi_clock_hz_ = clean_clock_hz / 100 * (100 - SPI_CLOCK_CALIBRATION_MARGIN_PERCENT);
+        snprintf(buffer, sizeof(buffer), "SPI clock calibrated: clean up to %u Hz, using %u Hz",
+            clean_clock_hz, spi_clock_hz_);
+    }
+    log(buffer);
+    motor_sensor_io_set_clock(spi_clock_hz_);
+}
+#endif
+
+#if MAX_MODULE_STARTS_PER_POWER_CHANNEL
+void SplitflapTask::admitModule(uint8_t i) {
+    starting_modules_.Add(i);
+    start_millis_[i] = millis();
+    starting_count_[getPowerChannelForModuleIndex(i)]++;
+    active_modules_.Add(i);
+}
+
+void SplitflapTask::updateAdmission() {
+    uint32_t now = millis();
+    for (int16_t n = starting_modules_.Size() - 1; n >= 0; n--) {
+        uint8_t i = starting_modules_[n];
+        // A module that hasn't taken its first step yet (current_accel_step still 0) is still starting
+        bool started = modules[i]->current_accel_step > 0 && !modules[i]->IsAccelerating();
+        if (started || modules[i]->IsIdle() || now - start_millis_[i] >= MODULE_START_TIMEOUT_MILLIS) {
+            starting_count_[getPowerChannelForModuleIndex(i)]--;
+            starting_modules_.RemoveAt(n);
+        }
+    }
+    for (int16_t n = pending_starts_.Size() - 1; n >= 0; n--) {
+        uint8_t i = pending_starts_[n];
+        if (starting_count_[getPowerChannelForModuleIndex(i)] < MAX_MODULE_STARTS_PER_POWER_CHANNEL) {
+            pending_starts_.RemoveAt(n);
+            admitModule(i);
+        }
+    }
+}
+#endif
+
 void SplitflapTask::runUpdate() {
-    boolean all_idle = true;
+#if FRAME_CLOCK
+    // Wait for the next frame and latch the motor outputs computed during the previous one straight away, so the
+    // time at which a step reaches the motors doesn't depend on how much work the rest of the loop did. If a pass
+    // overruns its frame, frame_count has moved on by more than one and the modules catch up on the next Update.
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t frame = frame_count;
+    motor_sensor_io();
+#endif
 
     uint32_t iterationStartMillis = millis();
 
@@ -204,53 +760,129 @@ void SplitflapTask::runUpdate() {
     uint8_t flashPhase = flashStep % 2;
 
     if (sensor_test_ && all_stopped_) {
+#if !FRAME_CLOCK
       // Read sensor state
       motor_sensor_io();
+#endif
 
 #ifdef CHAINLINK
       if (led_mode_ == LedMode::AUTO) {
         for (uint8_t i = 0; i < NUM_MODULES; i++) {
           chainlink_set_led(i, modules[i]->GetHomeState());
         }
+        // Restore the flash pattern as soon as the sensor test ends
+        last_flash_step_ = UINT32_MAX;
         // Output LED state
         motor_sensor_io();
       }
 #endif
     } else {
+      if (queued_modules_.Size() > 0) {
+        updateQueuedTargets();
+      }
+#if SPEED_CALIBRATION
+      if (calibrating_modules_.Size() > 0) {
+        updateSpeedCalibration();
+      }
+#endif
+#if LAZY_HOMING
+      if (deferred_count_ > 0 || background_homing_.Size() > 0) {
+        updateBackgroundHoming();
+      }
+#endif
+#if MAX_MODULE_STARTS_PER_POWER_CHANNEL
+      updateAdmission();
+      all_stopped_ = pending_starts_.Size() == 0;
+#else
       all_stopped_ = true;
-      for (uint8_t i = 0; i < NUM_MODULES; i++) {
-        modules[i]->Update();
-        bool is_idle = modules[i]->state == PANIC
-          || modules[i]->state == STATE_DISABLED
-          || modules[i]->state == LOOK_FOR_HOME
-          || modules[i]->state == SENSOR_ERROR
-          || (modules[i]->state == NORMAL && modules[i]->current_accel_step == 0);
-
+#endif
+#if FRAME_CLOCK
+      unsigned long now = frame;
+#else
+      unsigned long now = micros();
+#endif
+      // Iterate from the end so that idle modules can be removed from the active set in place
+      for (int16_t n = active_modules_.Size() - 1; n >= 0; n--) {
+        uint8_t i = active_modules_[n];
+#if MAX_MODULE_STARTS_PER_POWER_CHANNEL
+        if (pending_starts_.Contains(i)) {
+          // Woken by a sensor change while waiting for a start slot; leave it alone until admitted
+          continue;
+        }
+#endif
+#if BATCH_STEPPING
+        splitflap_batch.UpdateModule(i, now);
+#else
+        modules[i]->Update(now);
+#endif
         bool is_stopped = modules[i]->state == PANIC
           || modules[i]->state == STATE_DISABLED
           || modules[i]->current_accel_step == 0;
+        all_stopped_ &= is_stopped;
 
-#ifdef CHAINLINK
-        if (led_mode_ == LedMode::AUTO) {
-          chainlink_set_led(i, flashGroup < modules[i]->state && flashPhase == 0);
+        if (modules[i]->IsIdle()) {
+          active_modules_.RemoveAt(n);
         }
-#endif
+      }
 
-        all_idle &= is_idle;
-        all_stopped_ &= is_stopped;
+#ifdef CHAINLINK
+      // Error flash pattern only changes every flash step, so there's no need to touch every LED on every pass
+      if (led_mode_ == LedMode::AUTO && flashStep != last_flash_step_) {
+        for (uint8_t i = 0; i < NUM_MODULES; i++) {
+          chainlink_set_led(i, flashGroup < modules[i]->state && flashPhase == 0
+#if LAZY_HOMING
+              && !homing_deferred_[i]
+#endif
+          );
+        }
+        last_flash_step_ = flashStep;
       }
+#endif
+#if !FRAME_CLOCK
       motor_sensor_io();
+#endif
+      active_modules_.AddSensorChanges(sensor_buffer, last_sensor_buffer, SENSOR_BUFFER_LENGTH, SENSOR_MODULES_PER_BYTE, NUM_MODULES);
     }
 
 
-#if defined(CHAINLINK) && CHAINLINK_ENFORCE_LOOPBACKS
+#if defined(CHAINLINK) && CHAINLINK_ENFORCE_LOOPBACKS && CODED_LOOPBACKS
+    // Every pass checks all the loopback inputs against the pattern set MOTOR_SENSOR_IO_ROUND_TRIP passes ago, and then
+    // sets the next pattern in the cycle.
+    if (loopback_patterns_set_ == MOTOR_SENSOR_IO_ROUND_TRIP) {
+      uint8_t pattern = (loopback_pattern_ + 2 * CHAINLINK_LOOPBACK_PATTERNS - MOTOR_SENSOR_IO_ROUND_TRIP) % CHAINLINK_LOOPBACK_PATTERNS;
+      uint8_t failed = chainlink_check_loopback_pattern(pattern);
+      loopback_current_ok_ &= failed == NUM_LOOPBACKS;
+
+      if (failed != NUM_LOOPBACKS && loopback_all_ok_) {
+        // Publish failures immediately
+        loopback_all_ok_ = false;
+        char buffer[80];
+        snprintf(buffer, sizeof(buffer), "Loopback ERROR! Input %u read back wrong in pattern %u", failed, pattern);
+        log(buffer);
+        disableAll();
+      }
+
+      // Save the results once a whole cycle of patterns has been checked
+      if (pattern == CHAINLINK_LOOPBACK_PATTERNS - 1) {
+        if (loopback_current_ok_ && !loopback_all_ok_) {
+            log("Loopback is ok!");
+        }
+        loopback_all_ok_ = loopback_current_ok_;
+        loopback_current_ok_ = true;
+      }
+    } else {
+      loopback_patterns_set_++;
+    }
+    chainlink_set_loopback_pattern(loopback_pattern_);
+    loopback_pattern_ = (loopback_pattern_ + 1) % CHAINLINK_LOOPBACK_PATTERNS;
+#elif defined(CHAINLINK) && CHAINLINK_ENFORCE_LOOPBACKS
     // We test loopbacks iteratively, so as not to waste too many cycles/IO-roundtrips all at once. There are
     // two levels of iteration - loopback_step_index_ tracks the small intermediate steps of testing a single
     // loopback, and loopback_current_out_index_ tracks which loopback we're currently testing.
     loopback_step_index_++;
     if (loopback_step_index_ == 1) {
       chainlink_set_loopback(loopback_current_out_index_);
-    } else if (loopback_step_index_ == 3) {
+    } else if (loopback_step_index_ == 1 + MOTOR_SENSOR_IO_ROUND_TRIP) {
       bool ok = chainlink_validate_loopback(loopback_current_out_index_, nullptr);
       loopback_current_ok_ &= ok;
 
@@ -281,6 +913,98 @@ void SplitflapTask::runUpdate() {
     updateStateCache();
 }
 
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+void SplitflapTask::loadHomeCalibration() {
+    size_t length = preferences_.getBytesLength(HOME_CALIBRATION_NVS_KEY);
+    if (length == 0) {
+        return;
+    }
+    if (length != sizeof(saved_home_calibration_)) {
+        // Saved for a different number of modules; relearn from scratch
+        char buffer[100] = {};
+        snprintf(buffer, sizeof(buffer), "Ignoring saved home calibration of %u bytes (expected %u)", (unsigned)length, (unsigned)sizeof(saved_home_calibration_));
+        log(buffer);
+        return;
+    }
+    preferences_.getBytes(HOME_CALIBRATION_NVS_KEY, saved_home_calibration_, sizeof(saved_home_calibration_));
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        modules[i]->SetHomeCalibration(saved_home_calibration_[i]);
+    }
+    log("Loaded home calibration");
+}
+
+void SplitflapTask::saveHomeCalibration() {
+    uint32_t now = millis();
+    if (now - last_home_calibration_save_millis_ < HOME_CALIBRATION_SAVE_INTERVAL_MILLIS) {
+        return;
+    }
+    last_home_calibration_save_millis_ = now;
+
+    bool changed = false;
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        HomeCalibration calibration = modules[i]->GetHomeCalibration();
+        HomeCalibration& saved = saved_home_calibration_[i];
+        if (calibration.offset != saved.offset || calibration.spread != saved.spread || calibration.samples != saved.samples) {
+            saved.offset = calibration.offset;
+            saved.spread = calibration.spread;
+            saved.samples = calibration.samples;
+            changed = true;
+        }
+    }
+    if (changed) {
+        preferences_.putBytes(HOME_CALIBRATION_NVS_KEY, saved_home_calibration_, sizeof(saved_home_calibration_));
+    }
+}
+#endif
+
+#if WARM_BOOT_RESUME
+// Returns true if this is a warm boot with a valid saved state, in which case current_configs_ is restored from it
+bool SplitflapTask::loadResumeState() {
+    esp_reset_reason_t reason = esp_reset_reason();
+    bool warm_boot = reason == ESP_RST_SW
+        || reason == ESP_RST_PANIC
+        || reason == ESP_RST_INT_WDT
+        || reason == ESP_RST_TASK_WDT
+        || reason == ESP_RST_WDT
+        || reason == ESP_RST_BROWNOUT;
+    if (!warm_boot
+            || resume_state.magic != RESUME_STATE_MAGIC
+            || resume_state.gear_ratio_input_steps != GEAR_RATIO_INPUT_STEPS
+            || resume_state.crc != resumeStateCrc()) {
+        return false;
+    }
+    current_configs_ = resume_state.configs;
+    log("Warm boot, resuming from saved positions");
+    return true;
+}
+
+void SplitflapTask::saveResumeState() {
+    resume_state.magic = RESUME_STATE_MAGIC;
+    resume_state.gear_ratio_input_steps = GEAR_RATIO_INPUT_STEPS;
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+#if LAZY_HOMING
+        // A module reset with its homing deferred rests at step 0 without knowing where its spool is, so it has to
+        // home again after the restart too
+        if (homing_deferred_[i]) {
+            resume_state.positions[i].step = RESUME_STEP_NONE;
+            continue;
+        }
+#endif
+        if (!modules[i]->GetRestingPosition(resume_state.positions[i])) {
+            resume_state.positions[i].step = RESUME_STEP_NONE;
+        }
+    }
+    resume_state.configs = current_configs_;
+    resume_state.crc = resumeStateCrc();
+    resume_state_saved_ = true;
+}
+
+void SplitflapTask::invalidateResumeState() {
+    resume_state.magic = 0;
+    resume_state_saved_ = false;
+}
+#endif
+
 int8_t SplitflapTask::findFlapIndex(uint8_t character) {
     for (int8_t i = 0; i < NUM_FLAPS; i++) {
         if (character == flaps[i]) {
@@ -296,6 +1020,12 @@ void SplitflapTask::updateStateCache() {
     for (uint8_t i = 0; i < NUM_MODULES; i++) {
       new_state.modules[i].flap_index = modules[i]->GetCurrentFlapIndex();
       new_state.modules[i].state = modules[i]->state;
+#if LAZY_HOMING
+      if (homing_deferred_[i]) {
+        // Reported as waiting to home rather than as the sensor error an unhomed module is otherwise in
+        new_state.modules[i].state = LOOK_FOR_HOME;
+      }
+#endif
       new_state.modules[i].moving = modules[i]->current_accel_step > 0;
       new_state.modules[i].home_state = modules[i]->GetHomeState();
       new_state.modules[i].count_missed_home = modules[i]->count_missed_home;
@@ -304,6 +1034,9 @@ void SplitflapTask::updateStateCache() {
 
 #ifdef CHAINLINK
     new_state.loopbacks_ok = loopback_all_ok_;
+#endif
+#if SPI_CLOCK_CALIBRATION
+    new_state.spi_clock_hz = spi_clock_hz_;
 #endif
     if (memcmp(&state_cache_, &new_state, sizeof(state_cache_))) {
         SemaphoreGuard lock(state_semaphore_);
@@ -369,6 +1102,32 @@ SplitflapState SplitflapTask::getState() {
     return state_cache_;
 }
 
+#if STEP_TIMING_STATS
+// Copies the step timing of the most recent complete window into stats (NUM_MODULES entries) if it's newer than
+// last_window, and returns that window's number (0 until the first window completes)
+uint32_t SplitflapTask::getStepTimingStats(StepTimingStats* stats, uint32_t last_window) {
+    SemaphoreGuard lock(state_semaphore_);
+    if (step_timing_window_ != last_window) {
+        memcpy(stats, step_timing_cache_, sizeof(step_timing_cache_));
+    }
+    return step_timing_window_;
+}
+
+void SplitflapTask::collectStepTimingStats() {
+    {
+        SemaphoreGuard lock(state_semaphore_);
+        for (uint8_t i = 0; i < NUM_MODULES; i++) {
+            step_timing_cache_[i] = modules[i]->GetStepTimingStats();
+        }
+        step_timing_window_++;
+    }
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        modules[i]->ResetStepTimingStats();
+    }
+    last_step_timing_millis_ = millis();
+}
+#endif
+
 void SplitflapTask::setLogger(Logger* logger) {
     logger_ = logger;
 }
@@ -17,10 +17,25 @@
 
 #include "config.h"
 #include "logger.h"
+#include "power_channels.h"
+#include "target_queue.h"
+#include "src/active_module_set.h"
 #include "src/splitflap_module_data.h"
 
 #include "task.h"
 
+#if (HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS) || SPEED_CALIBRATION
+#include <Preferences.h>
+#endif
+
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+#include "src/home_calibration.h"
+#endif
+
+#if STEP_TIMING_STATS
+#include "src/step_timing_stats.h"
+#endif
+
 enum class SplitflapMode {
     MODE_RUN,
     MODE_SENSOR_TEST,
@@ -55,6 +70,9 @@ struct SplitflapState {
 #ifdef CHAINLINK
     bool loopbacks_ok = false;
 #endif
+#if SPI_CLOCK_CALIBRATION
+    uint32_t spi_clock_hz = 0;
+#endif
 
     bool operator==(const SplitflapState& other) {
         for (uint8_t i = 0; i < NUM_MODULES; i++) {
@@ -66,6 +84,9 @@ struct SplitflapState {
         return mode == other.mode
 #ifdef CHAINLINK
             && loopbacks_ok == other.loopbacks_ok
+#endif
+#if SPI_CLOCK_CALIBRATION
+            && spi_clock_hz == other.spi_clock_hz
 #endif
             ;
     }
@@ -85,23 +106,47 @@ enum class CommandType {
     SENSOR_TEST_SET,
     SENSOR_TEST_CLEAR,
     CONFIG,
+    QUEUE_TARGETS,
+    CALIBRATE_SPEED,
 };
 
 struct ModuleConfig {
     uint8_t target_flap_index;
     uint8_t movement_nonce;
     uint8_t reset_nonce;
+    uint8_t motion_profile;
 };
 
 struct ModuleConfigs {
     ModuleConfig config[NUM_MODULES];
 };
 
+#define QUEUED_TARGET_NONE 0xFF
+
+struct QueuedTarget {
+    uint8_t flap_index;     // QUEUED_TARGET_NONE to leave the module's queue unchanged
+    uint16_t dwell_millis;  // How long to stay on flap_index before starting the next queued target
+};
+
+#if SPEED_CALIBRATION
+// Progress of one module's speed calibration sweep
+struct SpeedCalibrationRun {
+    uint16_t min_period_micros;         // Step period cap being tried
+    uint16_t passed_min_period_micros;  // Shortest cap that has completed its revolutions cleanly (0 if none yet)
+    uint8_t revolutions_left;           // Revolutions still to run at min_period_micros
+    uint8_t count_missed_home;          // Module's error counters when the sweep started
+    uint8_t count_unexpected_home;
+    uint8_t motion_profile;             // Restored when the sweep ends
+    uint8_t target_flap_index;          // Returned to when the sweep ends
+};
+#endif
+
 struct Command {
     CommandType command_type;
     union CommandData {
-        uint8_t module_command[NUM_MODULES];
+        uint8_t module_command[NUM_MODULES];  // Also used by CALIBRATE_SPEED: non-zero to calibrate the module
         ModuleConfigs module_configs;
+        QueuedTarget queued_targets[NUM_MODULES];
     };
     CommandData data;
 };
@@ -129,6 +174,9 @@ class SplitflapTask : public Task<SplitflapTask> {
         void setSensorTest(bool sensor_test);
         void setLogger(Logger* logger);
         void postRawCommand(Command command);
+#if STEP_TIMING_STATS
+        uint32_t getStepTimingStats(StepTimingStats* stats, uint32_t last_window);
+#endif
 
     protected:
         void run();
@@ -142,6 +190,97 @@ class SplitflapTask : public Task<SplitflapTask> {
 
         bool all_stopped_ = true;
 
+        // Modules that are updated on every pass of runUpdate. Idle modules drop out until a command or a change in
+        // their home sensor input adds them back.
+        ActiveModuleSet<NUM_MODULES> active_modules_;
+        uint32_t last_flash_step_ = UINT32_MAX;
+
+        // Targets queued behind each module's current move. Modules with queued targets (or still dwelling on the last
+        // one) are tracked in queued_modules_; the next target starts once the module has been at rest for the
+        // current target's dwell time.
+        TargetQueues<NUM_MODULES, TARGET_QUEUE_DEPTH> target_queues_;
+        ActiveModuleSet<NUM_MODULES> queued_modules_;
+        uint16_t dwell_millis_[NUM_MODULES] = {};
+        uint32_t dwell_start_millis_[NUM_MODULES] = {};
+
+#if MAX_MODULE_STARTS_PER_POWER_CHANNEL
+        // Motion admission: a stopped module that is commanded to move holds one of its power channel's start slots
+        // until it has finished accelerating (or for MODULE_START_TIMEOUT_MILLIS at most). If none is free it waits in
+        // pending_starts_ (and isn't updated) until one is.
+        ActiveModuleSet<NUM_MODULES> pending_starts_;
+        ActiveModuleSet<NUM_MODULES> starting_modules_;
+        uint32_t start_millis_[NUM_MODULES] = {};
+        uint8_t starting_count_[NUM_MODULE_POWER_CHANNELS] = {};
+
+        void admitModule(uint8_t i);
+        void updateAdmission();
+#endif
+
+#if (HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS) || SPEED_CALIBRATION
+        Preferences preferences_;
+#endif
+
+#if HOME_CALIBRATION_ENABLED && ADAPTIVE_HOME_WINDOWS
+        // Learned home calibration is restored from NVS at boot and written back when it has changed, at most every
+        // HOME_CALIBRATION_SAVE_INTERVAL_MILLIS and only while every module is stopped (flash writes stall both cores).
+        HomeCalibration saved_home_calibration_[NUM_MODULES] = {};
+        uint32_t last_home_calibration_save_millis_ = 0;
+
+        void loadHomeCalibration();
+        void saveHomeCalibration();
+#endif
+
+#if LAZY_HOMING
+        // Modules whose homing is deferred until they're first sent a flap (or the background pass gets to them), and
+        // the modules the background pass is currently homing.
+        bool homing_deferred_[NUM_MODULES] = {};
+        uint8_t deferred_count_ = 0;
+        uint8_t background_homing_cursor_ = 0;
+        ActiveModuleSet<NUM_MODULES> background_homing_;
+
+        void deferHoming(uint8_t i);
+        bool cancelDeferredHoming(uint8_t i);
+        void homeIfDeferred(uint8_t i);
+        void updateBackgroundHoming();
+#endif
+
+#if SPEED_CALIBRATION
+        // Each module's minimum step period (the calibrated one, or ACCEL_FAST_MIN_PERIOD_MICROS if it has never been
+        // calibrated), restored from NVS at boot and written back once every module is stopped after a sweep changes
+        // it. Modules being calibrated are tracked in calibrating_modules_.
+        uint16_t min_step_period_micros_[NUM_MODULES] = {};
+        bool speed_calibration_changed_ = false;
+        SpeedCalibrationRun speed_calibration_[NUM_MODULES] = {};
+        ActiveModuleSet<NUM_MODULES> calibrating_modules_;
+
+        void loadSpeedCalibration();
+        void saveSpeedCalibration();
+        void startSpeedCalibration(uint8_t i);
+        void cancelSpeedCalibration(uint8_t i);
+        void finishSpeedCalibration(uint8_t i);
+        void updateSpeedCalibration();
+#endif
+
+#if STEP_TIMING_STATS
+        // Each module's step timing over the last complete STEP_TIMING_STATS_INTERVAL_MILLIS window, and the number of
+        // windows completed so far. Protected by state_semaphore_
+        StepTimingStats step_timing_cache_[NUM_MODULES] = {};
+        uint32_t step_timing_window_ = 0;
+        uint32_t last_step_timing_millis_ = 0;
+
+        void collectStepTimingStats();
+#endif
+
+#if WARM_BOOT_RESUME
+        // Whether the resting position of every module is currently saved for a warm boot. Saved whenever the chain
+        // comes to rest, and invalidated by any command or as soon as anything starts moving.
+        bool resume_state_saved_ = false;
+
+        bool loadResumeState();
+        void saveResumeState();
+        void invalidateResumeState();
+#endif
+
         uint32_t last_sensor_print_millis_ = 0;
         bool sensor_test_ = SENSOR_TEST;
         ModuleConfigs current_configs_ = {};
@@ -151,6 +290,18 @@ class SplitflapTask : public Task<SplitflapTask> {
         uint16_t loopback_step_index_ = 0;
         bool loopback_current_ok_ = true;
         bool loopback_all_ok_ = false;
+#if CODED_LOOPBACKS
+        // Coded pattern to set on the next pass, and how many passes have set one (up to MOTOR_SENSOR_IO_ROUND_TRIP)
+        uint8_t loopback_pattern_ = 0;
+        uint8_t loopback_patterns_set_ = 0;
+#endif
+#endif
+
+#if SPI_CLOCK_CALIBRATION
+        // Clock the chain is shifted at, as picked by calibrateSpiClock() at startup
+        uint32_t spi_clock_hz_ = 0;
+
+        void calibrateSpiClock();
 #endif
 
         // Cached state. Protected by state_semaphore_
@@ -158,6 +309,9 @@ class SplitflapTask : public Task<SplitflapTask> {
         void updateStateCache();
 
         void processQueue();
+        void startModule(uint8_t i);
+        void clearQueuedTargets(uint8_t i);
+        void updateQueuedTargets();
         void runUpdate();
         void sensorTestUpdate();
         void log(const char* msg);
@@ -0,0 +1,66 @@
+/*
+   Copyright 2021 Scott Bezek and the splitflap contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <Arduino.h>
+
+// Fixed-size FIFO of pending flap targets for each module, each with the time to hold that flap after arriving before
+// moving on to the next one.
+template <uint8_t MAX_MODULES, uint8_t DEPTH>
+class TargetQueues {
+    public:
+        // Returns false (and drops the target) if the module's queue is full
+        bool Push(uint8_t module, uint8_t flap_index, uint16_t dwell_millis) {
+            if (count_[module] == DEPTH) {
+                return false;
+            }
+            uint8_t slot = head_[module] + count_[module];
+            if (slot >= DEPTH) {
+                slot -= DEPTH;
+            }
+            flap_index_[module][slot] = flap_index;
+            dwell_millis_[module][slot] = dwell_millis;
+            count_[module]++;
+            return true;
+        }
+
+        bool Pop(uint8_t module, uint8_t* flap_index, uint16_t* dwell_millis) {
+            if (count_[module] == 0) {
+                return false;
+            }
+            uint8_t slot = head_[module];
+            *flap_index = flap_index_[module][slot];
+            *dwell_millis = dwell_millis_[module][slot];
+            head_[module] = slot + 1 == DEPTH ? 0 : slot + 1;
+            count_[module]--;
+            return true;
+        }
+
+        void Clear(uint8_t module) {
+            head_[module] = 0;
+            count_[module] = 0;
+        }
+
+        uint8_t Count(uint8_t module) const {
+            return count_[module];
+        }
+
+    private:
+        uint8_t flap_index_[MAX_MODULES][DEPTH];
+        uint16_t dwell_millis_[MAX_MODULES][DEPTH];
+        uint8_t head_[MAX_MODULES] = {};
+        uint8_t count_[MAX_MODULES] = {};
+};
@@ -27,6 +27,12 @@ PB_BIND(PB_SupervisorState_PowerChannelState, PB_SupervisorState_PowerChannelSta
 PB_BIND(PB_SupervisorState_FaultInfo, PB_SupervisorState_FaultInfo, 2)
 
 
+PB_BIND(PB_StepTimingStats, PB_StepTimingStats, 2)
+
+
+PB_BIND(PB_StepTimingStats_ModuleStepTiming, PB_StepTimingStats_ModuleStepTiming, AUTO)
+
+
 PB_BIND(PB_FromSplitflap, PB_FromSplitflap, 4)
 
 
@@ -45,7 +51,7 @@ PB_BIND(PB_SplitflapConfig_ModuleConfig, PB_SplitflapConfig_ModuleConfig, AUTO)
 PB_BIND(PB_RequestState, PB_RequestState, AUTO)
 
 
-PB_BIND(PB_ToSplitflap, PB_ToSplitflap, 2)
+PB_BIND(PB_ToSplitflap, PB_ToSplitflap, 4)
 
 
 
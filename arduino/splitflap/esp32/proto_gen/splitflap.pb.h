@@ -40,7 +40,9 @@ typedef enum _PB_SupervisorState_FaultInfo_FaultType {
 typedef enum _PB_SplitflapCommand_ModuleCommand_Action { 
     PB_SplitflapCommand_ModuleCommand_Action_NO_OP = 0, 
     PB_SplitflapCommand_ModuleCommand_Action_GO_TO_FLAP = 1, 
-    PB_SplitflapCommand_ModuleCommand_Action_RESET_AND_HOME = 2 
+    PB_SplitflapCommand_ModuleCommand_Action_RESET_AND_HOME = 2, 
+    PB_SplitflapCommand_ModuleCommand_Action_QUEUE_FLAP = 3, 
+    PB_SplitflapCommand_ModuleCommand_Action_CALIBRATE_SPEED = 4 
 } PB_SplitflapCommand_ModuleCommand_Action;
 
 /* Struct definitions */
@@ -59,12 +61,14 @@ typedef struct _PB_Log {
 typedef struct _PB_SplitflapCommand_ModuleCommand { 
     PB_SplitflapCommand_ModuleCommand_Action action; 
     uint8_t param; 
+    uint16_t dwell_millis; 
 } PB_SplitflapCommand_ModuleCommand;
 
 typedef struct _PB_SplitflapConfig_ModuleConfig { 
     uint8_t target_flap_index; 
     uint8_t movement_nonce; 
     uint8_t reset_nonce; 
+    uint8_t motion_profile; 
 } PB_SplitflapConfig_ModuleConfig;
 
 typedef struct _PB_SplitflapState_ModuleState { 
@@ -76,6 +80,12 @@ typedef struct _PB_SplitflapState_ModuleState {
     uint8_t count_missed_home; 
 } PB_SplitflapState_ModuleState;
 
+typedef struct _PB_StepTimingStats_ModuleStepTiming { 
+    pb_size_t late_steps_count;
+    uint16_t late_steps[12]; 
+    uint16_t max_late; 
+} PB_StepTimingStats_ModuleStepTiming;
+
 typedef struct _PB_SupervisorState_FaultInfo { 
     PB_SupervisorState_FaultInfo_FaultType type; 
     char msg[256]; 
@@ -101,8 +111,17 @@ typedef struct _PB_SplitflapConfig {
 typedef struct _PB_SplitflapState { 
     pb_size_t modules_count;
     PB_SplitflapState_ModuleState modules[255]; 
+    uint32_t spi_clock_hz; 
 } PB_SplitflapState;
 
+typedef struct _PB_StepTimingStats { 
+    uint16_t unit_micros; 
+    uint32_t window_millis; 
+    pb_size_t modules_count;
+    PB_StepTimingStats_ModuleStepTiming modules[64]; 
+    uint8_t first_module; 
+} PB_StepTimingStats;
+
 typedef struct _PB_SupervisorState { 
     uint32_t uptime_millis; 
     PB_SupervisorState_State state; 
@@ -119,6 +138,7 @@ typedef struct _PB_FromSplitflap {
         PB_Log log;
         PB_Ack ack;
         PB_SupervisorState supervisor_state;
+        PB_StepTimingStats step_timing_stats;
     } payload; 
 } PB_FromSplitflap;
 
@@ -147,8 +167,8 @@ typedef struct _PB_ToSplitflap {
 #define _PB_SupervisorState_FaultInfo_FaultType_ARRAYSIZE ((PB_SupervisorState_FaultInfo_FaultType)(PB_SupervisorState_FaultInfo_FaultType_UNEXPECTED_POWER+1))
 
 #define _PB_SplitflapCommand_ModuleCommand_Action_MIN PB_SplitflapCommand_ModuleCommand_Action_NO_OP
-#define _PB_SplitflapCommand_ModuleCommand_Action_MAX PB_SplitflapCommand_ModuleCommand_Action_RESET_AND_HOME
-#define _PB_SplitflapCommand_ModuleCommand_Action_ARRAYSIZE ((PB_SplitflapCommand_ModuleCommand_Action)(PB_SplitflapCommand_ModuleCommand_Action_RESET_AND_HOME+1))
+#define _PB_SplitflapCommand_ModuleCommand_Action_MAX PB_SplitflapCommand_ModuleCommand_Action_CALIBRATE_SPEED
+#define _PB_SplitflapCommand_ModuleCommand_Action_ARRAYSIZE ((PB_SplitflapCommand_ModuleCommand_Action)(PB_SplitflapCommand_ModuleCommand_Action_CALIBRATE_SPEED+1))
 
 
 #ifdef __cplusplus
@@ -156,32 +176,36 @@ extern "C" {
 #endif
 
 /* Initializer values for message structs */
-#define PB_SplitflapState_init_default           {0, {PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default}}
+#define PB_SplitflapState_init_default           {0, {PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default, PB_SplitflapState_ModuleState_init_default}, 0}
 #define PB_SplitflapState_ModuleState_init_default {_PB_SplitflapState_ModuleState_State_MIN, 0, 0, 0, 0, 0}
 #define PB_Log_init_default                      {""}
 #define PB_Ack_init_default                      {0}
 #define PB_SupervisorState_init_default          {0, _PB_SupervisorState_State_MIN, 0, {PB_SupervisorState_PowerChannelState_init_default, PB_SupervisorState_PowerChannelState_init_default, PB_SupervisorState_PowerChannelState_init_default, PB_SupervisorState_PowerChannelState_init_default, PB_SupervisorState_PowerChannelState_init_default}, false, PB_SupervisorState_FaultInfo_init_default}
 #define PB_SupervisorState_PowerChannelState_init_default {0, 0, 0}
 #define PB_SupervisorState_FaultInfo_init_default {_PB_SupervisorState_FaultInfo_FaultType_MIN, "", 0}
+#define PB_StepTimingStats_init_default          {0, 0, 0, {PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default, PB_StepTimingStats_ModuleStepTiming_init_default}, 0}
+#define PB_StepTimingStats_ModuleStepTiming_init_default {0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0}
 #define PB_FromSplitflap_init_default            {0, {PB_SplitflapState_init_default}}
 #define PB_SplitflapCommand_init_default         {0, {PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default, PB_SplitflapCommand_ModuleCommand_init_default}}
-#define PB_SplitflapCommand_ModuleCommand_init_default {_PB_SplitflapCommand_ModuleCommand_Action_MIN, 0}
+#define PB_SplitflapCommand_ModuleCommand_init_default {_PB_SplitflapCommand_ModuleCommand_Action_MIN, 0, 0}
 #define PB_SplitflapConfig_init_default          {0, {PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default, PB_SplitflapConfig_ModuleConfig_init_default}}
-#define PB_SplitflapConfig_ModuleConfig_init_default {0, 0, 0}
+#define PB_SplitflapConfig_ModuleConfig_init_default {0, 0, 0, 0}
 #define PB_RequestState_init_default             {0}
 #define PB_ToSplitflap_init_default              {0, 0, {PB_SplitflapCommand_init_default}}
-#define PB_SplitflapState_init_zero              {0, {PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero}}
+#define PB_SplitflapState_init_zero              {0, {PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero, PB_SplitflapState_ModuleState_init_zero}, 0}
 #define PB_SplitflapState_ModuleState_init_zero  {_PB_SplitflapState_ModuleState_State_MIN, 0, 0, 0, 0, 0}
 #define PB_Log_init_zero                         {""}
 #define PB_Ack_init_zero                         {0}
 #define PB_SupervisorState_init_zero             {0, _PB_SupervisorState_State_MIN, 0, {PB_SupervisorState_PowerChannelState_init_zero, PB_SupervisorState_PowerChannelState_init_zero, PB_SupervisorState_PowerChannelState_init_zero, PB_SupervisorState_PowerChannelState_init_zero, PB_SupervisorState_PowerChannelState_init_zero}, false, PB_SupervisorState_FaultInfo_init_zero}
 #define PB_SupervisorState_PowerChannelState_init_zero {0, 0, 0}
 #define PB_SupervisorState_FaultInfo_init_zero   {_PB_SupervisorState_FaultInfo_FaultType_MIN, "", 0}
+#define PB_StepTimingStats_init_zero             {0, 0, 0, {PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero, PB_StepTimingStats_ModuleStepTiming_init_zero}, 0}
+#define PB_StepTimingStats_ModuleStepTiming_init_zero {0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0}
 #define PB_FromSplitflap_init_zero               {0, {PB_SplitflapState_init_zero}}
 #define PB_SplitflapCommand_init_zero            {0, {PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero, PB_SplitflapCommand_ModuleCommand_init_zero}}
-#define PB_SplitflapCommand_ModuleCommand_init_zero {_PB_SplitflapCommand_ModuleCommand_Action_MIN, 0}
+#define PB_SplitflapCommand_ModuleCommand_init_zero {_PB_SplitflapCommand_ModuleCommand_Action_MIN, 0, 0}
 #define PB_SplitflapConfig_init_zero             {0, {PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero, PB_SplitflapConfig_ModuleConfig_init_zero}}
-#define PB_SplitflapConfig_ModuleConfig_init_zero {0, 0, 0}
+#define PB_SplitflapConfig_ModuleConfig_init_zero {0, 0, 0, 0}
 #define PB_RequestState_init_zero                {0}
 #define PB_ToSplitflap_init_zero                 {0, 0, {PB_SplitflapCommand_init_zero}}
 
@@ -190,15 +214,19 @@ extern "C" {
 #define PB_Log_msg_tag                           1
 #define PB_SplitflapCommand_ModuleCommand_action_tag 1
 #define PB_SplitflapCommand_ModuleCommand_param_tag 2
+#define PB_SplitflapCommand_ModuleCommand_dwell_millis_tag 3
 #define PB_SplitflapConfig_ModuleConfig_target_flap_index_tag 1
 #define PB_SplitflapConfig_ModuleConfig_movement_nonce_tag 2
 #define PB_SplitflapConfig_ModuleConfig_reset_nonce_tag 3
+#define PB_SplitflapConfig_ModuleConfig_motion_profile_tag 4
 #define PB_SplitflapState_ModuleState_state_tag  1
 #define PB_SplitflapState_ModuleState_flap_index_tag 2
 #define PB_SplitflapState_ModuleState_moving_tag 3
 #define PB_SplitflapState_ModuleState_home_state_tag 4
 #define PB_SplitflapState_ModuleState_count_unexpected_home_tag 5
 #define PB_SplitflapState_ModuleState_count_missed_home_tag 6
+#define PB_StepTimingStats_ModuleStepTiming_late_steps_tag 1
+#define PB_StepTimingStats_ModuleStepTiming_max_late_tag 2
 #define PB_SupervisorState_FaultInfo_type_tag    1
 #define PB_SupervisorState_FaultInfo_msg_tag     2
 #define PB_SupervisorState_FaultInfo_ts_millis_tag 3
@@ -208,6 +236,11 @@ extern "C" {
 #define PB_SplitflapCommand_modules_tag          2
 #define PB_SplitflapConfig_modules_tag           1
 #define PB_SplitflapState_modules_tag            1
+#define PB_SplitflapState_spi_clock_hz_tag       2
+#define PB_StepTimingStats_unit_micros_tag       1
+#define PB_StepTimingStats_window_millis_tag     2
+#define PB_StepTimingStats_modules_tag           3
+#define PB_StepTimingStats_first_module_tag      4
 #define PB_SupervisorState_uptime_millis_tag     1
 #define PB_SupervisorState_state_tag             2
 #define PB_SupervisorState_power_channels_tag    3
@@ -216,6 +249,7 @@ extern "C" {
 #define PB_FromSplitflap_log_tag                 2
 #define PB_FromSplitflap_ack_tag                 3
 #define PB_FromSplitflap_supervisor_state_tag    4
+#define PB_FromSplitflap_step_timing_stats_tag   5
 #define PB_ToSplitflap_nonce_tag                 1
 #define PB_ToSplitflap_splitflap_command_tag     2
 #define PB_ToSplitflap_splitflap_config_tag      3
@@ -223,7 +257,8 @@ extern "C" {
 
 /* Struct field encoding specification for nanopb */
 #define PB_SplitflapState_FIELDLIST(X, a) \
-X(a, STATIC,   REPEATED, MESSAGE,  modules,           1)
+X(a, STATIC,   REPEATED, MESSAGE,  modules,           1) \
+X(a, STATIC,   SINGULAR, UINT32,   spi_clock_hz,      2)
 #define PB_SplitflapState_CALLBACK NULL
 #define PB_SplitflapState_DEFAULT NULL
 #define PB_SplitflapState_modules_MSGTYPE PB_SplitflapState_ModuleState
@@ -272,17 +307,34 @@ X(a, STATIC,   SINGULAR, UINT32,   ts_millis,         3)
 #define PB_SupervisorState_FaultInfo_CALLBACK NULL
 #define PB_SupervisorState_FaultInfo_DEFAULT NULL
 
+#define PB_StepTimingStats_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   unit_micros,       1) \
+X(a, STATIC,   SINGULAR, UINT32,   window_millis,     2) \
+X(a, STATIC,   REPEATED, MESSAGE,  modules,           3) \
+X(a, STATIC,   SINGULAR, UINT32,   first_module,      4)
+#define PB_StepTimingStats_CALLBACK NULL
+#define PB_StepTimingStats_DEFAULT NULL
+#define PB_StepTimingStats_modules_MSGTYPE PB_StepTimingStats_ModuleStepTiming
+
+#define PB_StepTimingStats_ModuleStepTiming_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, UINT32,   late_steps,        1) \
+X(a, STATIC,   SINGULAR, UINT32,   max_late,          2)
+#define PB_StepTimingStats_ModuleStepTiming_CALLBACK NULL
+#define PB_StepTimingStats_ModuleStepTiming_DEFAULT NULL
+
 #define PB_FromSplitflap_FIELDLIST(X, a) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (payload,splitflap_state,payload.splitflap_state),   1) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (payload,log,payload.log),   2) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (payload,ack,payload.ack),   3) \
-X(a, STATIC,   ONEOF,    MESSAGE,  (payload,supervisor_state,payload.supervisor_state),   4)
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,supervisor_state,payload.supervisor_state),   4) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,step_timing_stats,payload.step_timing_stats),   5)
 #define PB_FromSplitflap_CALLBACK NULL
 #define PB_FromSplitflap_DEFAULT NULL
 #define PB_FromSplitflap_payload_splitflap_state_MSGTYPE PB_SplitflapState
 #define PB_FromSplitflap_payload_log_MSGTYPE PB_Log
 #define PB_FromSplitflap_payload_ack_MSGTYPE PB_Ack
 #define PB_FromSplitflap_payload_supervisor_state_MSGTYPE PB_SupervisorState
+#define PB_FromSplitflap_payload_step_timing_stats_MSGTYPE PB_StepTimingStats
 
 #define PB_SplitflapCommand_FIELDLIST(X, a) \
 X(a, STATIC,   REPEATED, MESSAGE,  modules,           2)
@@ -292,7 +344,8 @@ X(a, STATIC,   REPEATED, MESSAGE,  modules,           2)
 
 #define PB_SplitflapCommand_ModuleCommand_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UENUM,    action,            1) \
-X(a, STATIC,   SINGULAR, UINT32,   param,             2)
+X(a, STATIC,   SINGULAR, UINT32,   param,             2) \
+X(a, STATIC,   SINGULAR, UINT32,   dwell_millis,      3)
 #define PB_SplitflapCommand_ModuleCommand_CALLBACK NULL
 #define PB_SplitflapCommand_ModuleCommand_DEFAULT NULL
 
@@ -305,7 +358,8 @@ X(a, STATIC,   REPEATED, MESSAGE,  modules,           1)
 #define PB_SplitflapConfig_ModuleConfig_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UINT32,   target_flap_index,   1) \
 X(a, STATIC,   SINGULAR, UINT32,   movement_nonce,    2) \
-X(a, STATIC,   SINGULAR, UINT32,   reset_nonce,       3)
+X(a, STATIC,   SINGULAR, UINT32,   reset_nonce,       3) \
+X(a, STATIC,   SINGULAR, UINT32,   motion_profile,    4)
 #define PB_SplitflapConfig_ModuleConfig_CALLBACK NULL
 #define PB_SplitflapConfig_ModuleConfig_DEFAULT NULL
 
@@ -332,6 +386,8 @@ extern const pb_msgdesc_t PB_Ack_msg;
 extern const pb_msgdesc_t PB_SupervisorState_msg;
 extern const pb_msgdesc_t PB_SupervisorState_PowerChannelState_msg;
 extern const pb_msgdesc_t PB_SupervisorState_FaultInfo_msg;
+extern const pb_msgdesc_t PB_StepTimingStats_msg;
+extern const pb_msgdesc_t PB_StepTimingStats_ModuleStepTiming_msg;
 extern const pb_msgdesc_t PB_FromSplitflap_msg;
 extern const pb_msgdesc_t PB_SplitflapCommand_msg;
 extern const pb_msgdesc_t PB_SplitflapCommand_ModuleCommand_msg;
@@ -348,6 +404,8 @@ extern const pb_msgdesc_t PB_ToSplitflap_msg;
 #define PB_SupervisorState_fields &PB_SupervisorState_msg
 #define PB_SupervisorState_PowerChannelState_fields &PB_SupervisorState_PowerChannelState_msg
 #define PB_SupervisorState_FaultInfo_fields &PB_SupervisorState_FaultInfo_msg
+#define PB_StepTimingStats_fields &PB_StepTimingStats_msg
+#define PB_StepTimingStats_ModuleStepTiming_fields &PB_StepTimingStats_ModuleStepTiming_msg
 #define PB_FromSplitflap_fields &PB_FromSplitflap_msg
 #define PB_SplitflapCommand_fields &PB_SplitflapCommand_msg
 #define PB_SplitflapCommand_ModuleCommand_fields &PB_SplitflapCommand_ModuleCommand_msg
@@ -358,19 +416,21 @@ extern const pb_msgdesc_t PB_ToSplitflap_msg;
 
 /* Maximum encoded size of messages (where known) */
 #define PB_Ack_size                              6
-#define PB_FromSplitflap_size                    4338
+#define PB_FromSplitflap_size                    4344
 #define PB_Log_size                              258
 #define PB_RequestState_size                     0
-#define PB_SplitflapCommand_ModuleCommand_size   5
-#define PB_SplitflapCommand_size                 1785
-#define PB_SplitflapConfig_ModuleConfig_size     9
-#define PB_SplitflapConfig_size                  2805
+#define PB_SplitflapCommand_ModuleCommand_size   9
+#define PB_SplitflapCommand_size                 2805
+#define PB_SplitflapConfig_ModuleConfig_size     12
+#define PB_SplitflapConfig_size                  3570
 #define PB_SplitflapState_ModuleState_size       15
-#define PB_SplitflapState_size                   4335
+#define PB_SplitflapState_size                   4341
+#define PB_StepTimingStats_ModuleStepTiming_size 52
+#define PB_StepTimingStats_size                  3469
 #define PB_SupervisorState_FaultInfo_size        266
 #define PB_SupervisorState_PowerChannelState_size 12
 #define PB_SupervisorState_size                  347
-#define PB_ToSplitflap_size                      2814
+#define PB_ToSplitflap_size                      3579
 
 #ifdef __cplusplus
 } /* extern "C" */
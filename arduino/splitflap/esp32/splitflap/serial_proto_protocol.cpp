@@ -21,11 +21,21 @@
 #include "pb_decode.h"
 #include "serial_proto_protocol.h"
 
+#if STEP_TIMING_STATS
+#include "src/acceleration.h"
+#endif
+
 static SerialProtoProtocol* singleton_for_packet_serial = 0;
 
 static const uint16_t MIN_STATE_INTERVAL_MILLIS = 250;
 static const uint16_t PERIODIC_STATE_INTERVAL_MILLIS = 5000;
 
+#if STEP_TIMING_STATS
+// Step timing stats are sent in chunks of this many modules, so that they don't set the size of the largest
+// FromSplitflap message (and with it the tx buffers)
+static const uint8_t STEP_TIMING_STATS_MODULES_PER_MESSAGE = pb_arraysize(PB_StepTimingStats, modules);
+#endif
+
 SerialProtoProtocol::SerialProtoProtocol(SplitflapTask& splitflap_task, Stream& stream) :
         SerialProtocol(splitflap_task),
         stream_(stream) {
@@ -93,13 +103,50 @@ void SerialProtoProtocol::loop() {
                 .count_missed_home = latest_state_.modules[i].count_missed_home,
             };
         }
+#if SPI_CLOCK_CALIBRATION
+        pb_tx_buffer_.payload.splitflap_state.spi_clock_hz = latest_state_.spi_clock_hz;
+#endif
 
         sendPbTxBuffer();
 
         last_sent_state_ = latest_state_;
         last_sent_state_millis_ = millis();
     }
+
+#if STEP_TIMING_STATS
+    uint32_t step_timing_window = splitflap_task_.getStepTimingStats(step_timing_stats_, last_sent_step_timing_window_);
+    if (step_timing_window != last_sent_step_timing_window_) {
+        sendStepTimingStats();
+        last_sent_step_timing_window_ = step_timing_window;
+    }
+#endif
+}
+
+#if STEP_TIMING_STATS
+void SerialProtoProtocol::sendStepTimingStats() {
+    for (uint16_t first = 0; first < NUM_MODULES; first += STEP_TIMING_STATS_MODULES_PER_MESSAGE) {
+        pb_tx_buffer_ = {};
+        pb_tx_buffer_.which_payload = PB_FromSplitflap_step_timing_stats_tag;
+        PB_StepTimingStats& stats = pb_tx_buffer_.payload.step_timing_stats;
+#if FRAME_CLOCK
+        stats.unit_micros = Acceleration::FRAME_PERIOD_MICROS;
+#else
+        stats.unit_micros = 1;
+#endif
+        stats.window_millis = STEP_TIMING_STATS_INTERVAL_MILLIS;
+        stats.first_module = first;
+        stats.modules_count = min(NUM_MODULES - first, (int)STEP_TIMING_STATS_MODULES_PER_MESSAGE);
+        static_assert(sizeof(stats.modules[0].late_steps) == sizeof(step_timing_stats_[0].late_steps), "StepTimingStats buckets must match the proto");
+        for (uint8_t i = 0; i < stats.modules_count; i++) {
+            PB_StepTimingStats_ModuleStepTiming& module = stats.modules[i];
+            module.late_steps_count = STEP_TIMING_STATS_BUCKETS;
+            memcpy(module.late_steps, step_timing_stats_[first + i].late_steps, sizeof(module.late_steps));
+            module.max_late = step_timing_stats_[first + i].max_late;
+        }
+        sendPbTxBuffer();
+    }
 }
+#endif
 
 void SerialProtoProtocol::handlePacket(const uint8_t* buffer, size_t size) {
     if (size <= 4) {
@@ -145,9 +192,23 @@ void SerialProtoProtocol::handlePacket(const uint8_t* buffer, size_t size) {
     
     switch (pb_rx_buffer_.which_payload) {
         case PB_ToSplitflap_splitflap_command_tag: {
-            PB_SplitflapCommand command = pb_rx_buffer_.payload.splitflap_command;
+            const PB_SplitflapCommand& command = pb_rx_buffer_.payload.splitflap_command;
             Command c = {};
             c.command_type = CommandType::MODULES;
+
+            // QUEUE_FLAP actions are posted as a separate command after the immediate ones
+            Command queue_command = {};
+            queue_command.command_type = CommandType::QUEUE_TARGETS;
+            bool any_queued = false;
+            for (uint8_t i = 0; i < NUM_MODULES; i++) {
+                queue_command.data.queued_targets[i].flap_index = QUEUED_TARGET_NONE;
+            }
+
+            // As are CALIBRATE_SPEED actions
+            Command calibrate_command = {};
+            calibrate_command.command_type = CommandType::CALIBRATE_SPEED;
+            bool any_calibrate = false;
+
             for (uint8_t i = 0; i < min((int)command.modules_count, NUM_MODULES); i++) {
                 switch (command.modules[i].action) {
                     case PB_SplitflapCommand_ModuleCommand_Action_NO_OP:
@@ -161,12 +222,29 @@ void SerialProtoProtocol::handlePacket(const uint8_t* buffer, size_t size) {
                             c.data.module_command[i] = QCMD_FLAP + command.modules[i].param;
                         }
                         break;
+                    case PB_SplitflapCommand_ModuleCommand_Action_QUEUE_FLAP:
+                        if (command.modules[i].param < QUEUED_TARGET_NONE) {
+                            queue_command.data.queued_targets[i].flap_index = command.modules[i].param;
+                            queue_command.data.queued_targets[i].dwell_millis = command.modules[i].dwell_millis;
+                            any_queued = true;
+                        }
+                        break;
+                    case PB_SplitflapCommand_ModuleCommand_Action_CALIBRATE_SPEED:
+                        calibrate_command.data.module_command[i] = 1;
+                        any_calibrate = true;
+                        break;
                     default:
                         // Ignore unknown action
                         break;
                 }
             }
             splitflap_task_.postRawCommand(c);
+            if (any_queued) {
+                splitflap_task_.postRawCommand(queue_command);
+            }
+            if (any_calibrate) {
+                splitflap_task_.postRawCommand(calibrate_command);
+            }
             break;
         }
         case PB_ToSplitflap_splitflap_config_tag: {
@@ -178,6 +256,7 @@ void SerialProtoProtocol::handlePacket(const uint8_t* buffer, size_t size) {
                 module_config.target_flap_index = config.modules[i].target_flap_index;
                 module_config.movement_nonce = config.modules[i].movement_nonce;
                 module_config.reset_nonce = config.modules[i].reset_nonce;
+                module_config.motion_profile = config.modules[i].motion_profile;
             }
             splitflap_task_.postRawCommand(c);
             break;
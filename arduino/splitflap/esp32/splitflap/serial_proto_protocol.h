@@ -48,6 +48,13 @@ class SerialProtoProtocol : public SerialProtocol {
 
         bool state_requested_;
 
+#if STEP_TIMING_STATS
+        StepTimingStats step_timing_stats_[NUM_MODULES] = {};
+        uint32_t last_sent_step_timing_window_ = 0;
+
+        void sendStepTimingStats();
+#endif
+
         void sendPbTxBuffer();
         void handlePacket(const uint8_t* buffer, size_t size);
         void ack(uint32_t nonce);